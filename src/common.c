@@ -1,121 +1,1036 @@
+#define _DEFAULT_SOURCE
+
 #include "common.h"
 
-char* read_file(const char* filename) {
-    FILE* f = fopen(filename, "r");
-    if (!f) {
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+InputView map_file(const char* filename) {
+    InputView view = {0};
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
         fprintf(stderr, "Cannot open file: %s\n", filename);
-        return NULL;
+        return view;
     }
 
-    fseek(f, 0, SEEK_END);
-    long size = ftell(f);
-    fseek(f, 0, SEEK_SET);
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t size = st.st_size;
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t map_len = (size + 1 + page - 1) / page * page;
+
+        // Reserve zeroed pages one byte past the file, then map the file over
+        // them, so the byte after the last one is always a NUL terminator
+        void* base = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != MAP_FAILED) {
+            void* data = mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+            if (data != MAP_FAILED) {
+                posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+                close(fd);
+                view.data = data;
+                view.len = size;
+                view.map_len = map_len;
+                return view;
+            }
+            munmap(base, map_len);
+        }
+    }
 
-    char* buffer = malloc(size + 1);
-    if (!buffer) {
-        fclose(f);
-        return NULL;
+    // Fallback for pipes, empty files, and mmap failures
+    size_t capacity = 4096;
+    size_t len = 0;
+    char* buffer = malloc(capacity);
+    while (buffer) {
+        if (len + 1 >= capacity) {
+            capacity *= 2;
+            char* grown = realloc(buffer, capacity);
+            if (!grown) {
+                free(buffer);
+                buffer = NULL;
+                break;
+            }
+            buffer = grown;
+        }
+        ssize_t n = read(fd, buffer + len, capacity - len - 1);
+        if (n <= 0) break;
+        len += n;
     }
+    close(fd);
 
-    size_t read = fread(buffer, 1, size, f);
-    buffer[read] = '\0';
-    fclose(f);
+    if (buffer) {
+        buffer[len] = '\0';
+        view.data = buffer;
+        view.len = len;
+    }
+    return view;
+}
 
-    return buffer;
+void unmap_file(InputView* view) {
+    if (!view->data) return;
+    if (view->map_len > 0) {
+        munmap((void*)view->data, view->map_len);
+    } else {
+        free((void*)view->data);
+    }
+    view->data = NULL;
+    view->len = 0;
+    view->map_len = 0;
 }
 
-char* read_input(int day) {
+InputView read_input(int day) {
     char filename[64];
     snprintf(filename, sizeof(filename), "inputs/%02d-input.txt", day);
-    return read_file(filename);
+    return map_file(filename);
 }
 
-char* read_example(int day) {
+InputView read_example(int day) {
     char filename[64];
     snprintf(filename, sizeof(filename), "inputs/%02d-example.txt", day);
-    return read_file(filename);
+    return map_file(filename);
 }
 
-char* read_as_string(int day, const char* name) {
+InputView read_as_string(int day, const char* name) {
     char filename[64];
     snprintf(filename, sizeof(filename), "inputs/%02d-%s.txt", day, name);
-    return read_file(filename);
+    return map_file(filename);
 }
 
-int count_lines(const char* str) {
-    if (!str || !*str) return 0;
+bool read_answers(int day, const char* name, int64_t* part1, int64_t* part2) {
+    char filename[64];
+    snprintf(filename, sizeof(filename), "inputs/%02d-%s.answer", day, name);
+
+    FILE* f = fopen(filename, "r");
+    if (!f) return false;
+
+    long long a, b;
+    bool ok = fscanf(f, "%lld %lld", &a, &b) == 2;
+    fclose(f);
 
-    int count = 0;
-    for (const char* p = str; *p; p++) {
-        if (*p == '\n') count++;
+    if (ok) {
+        *part1 = a;
+        *part2 = b;
     }
-    // Count last line if it doesn't end with newline
-    size_t len = strlen(str);
-    if (len > 0 && str[len - 1] != '\n') count++;
-    return count;
+    return ok;
 }
 
-char** split_lines(const char* str, int* count) {
-    if (!str || !*str) {
-        *count = 0;
-        return NULL;
-    }
+LineIter lines_begin(const char* input, size_t len) {
+    LineIter it = { input, input + len };
+    while (it.end > it.cur && it.end[-1] == '\n') it.end--;
+    return it;
+}
+
+bool lines_next(LineIter* it, Span* line) {
+    if (it->cur >= it->end) return false;
+
+    const char* nl = scan_byte(it->cur, it->end, '\n');
+
+    line->ptr = it->cur;
+    line->len = nl - it->cur;
+    it->cur = nl < it->end ? nl + 1 : it->end;
+    return true;
+}
 
-    // First pass: count actual lines
+Span* collect_lines(const char* input, size_t len, int* count) {
     int capacity = 16;
-    char** lines = malloc(capacity * sizeof(char*));
-    if (!lines) {
-        *count = 0;
-        return NULL;
-    }
-
-    const char* start = str;
-    int idx = 0;
-
-    for (const char* p = str; ; p++) {
-        if (*p == '\n' || *p == '\0') {
-            size_t len = p - start;
-
-            // Skip empty lines at the end
-            if (len == 0 && *p == '\0') break;
-
-            // Grow array if needed
-            if (idx >= capacity) {
-                capacity *= 2;
-                char** new_lines = realloc(lines, capacity * sizeof(char*));
-                if (!new_lines) {
-                    free_lines(lines, idx);
-                    *count = 0;
-                    return NULL;
-                }
-                lines = new_lines;
-            }
+    Span* lines = malloc(capacity * sizeof(Span));
+    *count = 0;
 
-            lines[idx] = malloc(len + 1);
-            if (lines[idx]) {
-                memcpy(lines[idx], start, len);
-                lines[idx][len] = '\0';
-            }
-            idx++;
-            start = p + 1;
-            if (*p == '\0') break;
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line)) {
+        if (*count >= capacity) {
+            capacity *= 2;
+            lines = realloc(lines, capacity * sizeof(Span));
+        }
+        lines[(*count)++] = line;
+    }
+
+    return lines;
+}
+
+void line_stream_init(LineStream* s, int fd) {
+    s->fd = fd;
+    s->start = 0;
+    s->end = 0;
+    s->eof = false;
+}
+
+bool line_stream_next(LineStream* s, Span* line) {
+    for (;;) {
+        const char* data = s->buf + s->start;
+        const char* stop = s->buf + s->end;
+        const char* nl = scan_byte(data, stop, '\n');
+
+        // A full line, a final unterminated line, or a line filling the buffer
+        if (nl < stop || (s->eof && data < stop) || (s->start == 0 && s->end == sizeof(s->buf))) {
+            line->ptr = data;
+            line->len = nl - data;
+            s->start = (nl < stop ? nl + 1 : stop) - s->buf;
+            return true;
+        }
+        if (s->eof) return false;
+
+        // Move the partial line to the front and refill behind it
+        memmove(s->buf, data, stop - data);
+        s->end -= s->start;
+        s->start = 0;
+
+        ssize_t n = read(s->fd, s->buf + s->end, sizeof(s->buf) - s->end);
+        if (n > 0) {
+            s->end += n;
+        } else if (n == 0 || errno != EINTR) {
+            s->eof = true;
         }
     }
+}
 
-    // Remove trailing empty lines
-    while (idx > 0 && lines[idx - 1][0] == '\0') {
-        free(lines[idx - 1]);
-        idx--;
+const char* scan_byte(const char* p, const char* end, char c) {
+#if defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi8(c);
+    for (; end - p >= 32; p += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)p);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask) return p + __builtin_ctz(mask);
     }
+#elif defined(__SSE2__)
+    __m128i needle = _mm_set1_epi8(c);
+    for (; end - p >= 16; p += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)p);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#endif
+    while (p < end && *p != c) p++;
+    return p;
+}
 
-    *count = idx;
-    return lines;
+// Index of the first byte in [p, end) that is (want_digit) or is not
+// (!want_digit) an ASCII digit, or end
+static const char* scan_digit_class(const char* p, const char* end, bool want_digit) {
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i nine = _mm256_set1_epi8(9);
+    uint32_t flip = want_digit ? 0 : 0xFFFFFFFFu;
+    for (; end - p >= 32; p += 32) {
+        // c - '0' <= 9 (unsigned) exactly for digits
+        __m256i d = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i*)p), zero);
+        __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, nine), d);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(is_digit) ^ flip;
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    uint32_t flip = want_digit ? 0 : 0xFFFFu;
+    for (; end - p >= 16; p += 16) {
+        __m128i d = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)p), zero);
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(is_digit) ^ flip;
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#endif
+    while (p < end && (*p >= '0' && *p <= '9') != want_digit) p++;
+    return p;
+}
+
+// Value of up to 8 digits, combined pairwise in one 64-bit word (SWAR)
+static uint64_t parse_digits8(const char* p, size_t n) {
+    // Left-pad with '0' so the digits end up right-aligned in the word
+    char buf[8];
+    memset(buf, '0', sizeof(buf));
+    memcpy(buf + 8 - n, p, n);
+
+    uint64_t v;
+    memcpy(&v, buf, sizeof(v));
+    v -= 0x3030303030303030ULL;
+    v = v * 10 + (v >> 8);
+    v = ((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+         ((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    return v;
+}
+
+static uint64_t parse_digits(const char* p, size_t n) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (n <= 8) return parse_digits8(p, n);
+    if (n <= 16) return parse_digits8(p, n - 8) * 100000000ULL + parse_digits8(p + n - 8, 8);
+#endif
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; i++) v = v * 10 + (uint64_t)(p[i] - '0');
+    return v;
+}
+
+// Next run of digits in [*p, end) as [*digits, *digits + *n), leading
+// zeros dropped (one kept for zero); *p moves past the run
+static bool scan_digit_run(const char** p, const char* end, const char** digits, size_t* n) {
+    const char* start = scan_digit_class(*p, end, true);
+    if (start >= end) {
+        *p = end;
+        return false;
+    }
+    const char* stop = scan_digit_class(start, end, false);
+    *p = stop;
+    while (stop - start > 1 && *start == '0') start++;
+    *digits = start;
+    *n = stop - start;
+    return true;
+}
+
+bool scan_uint(const char** p, const char* end, uint64_t* value) {
+    const char* digits;
+    size_t n;
+    if (!scan_digit_run(p, end, &digits, &n)) return false;
+    if (n < 20) {
+        *value = parse_digits(digits, n);
+        return true;
+    }
+
+    // Only a 20th digit can take the value past UINT64_MAX
+    uint64_t v = parse_digits(digits, 19);
+    uint64_t d = (uint64_t)(digits[19] - '0');
+    if (n > 20 || v > (UINT64_MAX - d) / 10) return false;
+    *value = v * 10 + d;
+    return true;
+}
+
+bool scan_int(const char** p, const char* end, int* value) {
+    const char* digits;
+    size_t n;
+    if (!scan_digit_run(p, end, &digits, &n)) return false;
+    uint64_t v = parse_digits(digits, n < 11 ? n : 11);
+    if (n > 10 || v > INT_MAX) return false;
+    *value = (int)v;
+    return true;
+}
+
+bool scan_i64(const char** p, const char* end, int64_t* value) {
+    const char* from = *p;
+    const char* digits;
+    size_t n;
+    if (!scan_digit_run(p, end, &digits, &n)) return false;
+
+    // The sign belongs to the number only if it directly precedes the digits
+    // (leading zeros included)
+    const char* first = digits;
+    while (first > from && first[-1] == '0') first--;
+    bool negative = first > from && first[-1] == '-';
+
+    uint64_t magnitude = parse_digits(digits, n < 20 ? n : 20);
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (n > 19 || magnitude > limit) return false;
+    *value = negative ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude;
+    return true;
+}
+
+#define ARENA_MIN_BLOCK (64 * 1024)
+#define ARENA_ALIGN 16
+
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t size;
+    _Alignas(ARENA_ALIGN) unsigned char data[];
+};
+
+static ArenaBlock* arena_new_block(size_t size) {
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+    if (!block) {
+        fprintf(stderr, "Arena: out of memory\n");
+        exit(1);
+    }
+    block->next = NULL;
+    block->size = size;
+    return block;
+}
+
+void arena_init(Arena* arena) {
+    arena->first = arena_new_block(ARENA_MIN_BLOCK);
+    arena->current = arena->first;
+    arena->used = 0;
+}
+
+void arena_destroy(Arena* arena) {
+    ArenaBlock* block = arena->first;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->used = 0;
+}
+
+void arena_reset(Arena* arena) {
+    // If the last run spilled into extra blocks, replace them all with one
+    // block big enough for the whole run, so the next run stays contiguous
+    if (arena->first->next) {
+        size_t total = 0;
+        for (ArenaBlock* b = arena->first; b; b = b->next) total += b->size;
+        arena_destroy(arena);
+        arena->first = arena_new_block(total);
+    }
+    arena->current = arena->first;
+    arena->used = 0;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    while (arena->used + size > arena->current->size) {
+        // Move on to the next block, reusing one left over from a release
+        ArenaBlock* next = arena->current->next;
+        if (!next || next->size < size) {
+            size_t block_size = arena->current->size * 2;
+            if (block_size < size) block_size = size;
+            ArenaBlock* block = arena_new_block(block_size);
+            block->next = next;
+            arena->current->next = block;
+            next = block;
+        }
+        arena->current = next;
+        arena->used = 0;
+    }
+
+    void* ptr = arena->current->data + arena->used;
+    arena->used += size;
+    return ptr;
+}
+
+void* arena_calloc(Arena* arena, size_t count, size_t size) {
+    void* ptr = arena_alloc(arena, count * size);
+    memset(ptr, 0, count * size);
+    return ptr;
+}
+
+ArenaMark arena_mark(Arena* arena) {
+    return (ArenaMark){ arena->current, arena->used };
+}
+
+void arena_release(Arena* arena, ArenaMark mark) {
+    arena->current = mark.block;
+    arena->used = mark.used;
+}
+
+#ifdef __linux__
+static const uint64_t perf_event_configs[PERF_NUM_EVENTS] = {
+    [PERF_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+    [PERF_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+    [PERF_CACHE_REFS] = PERF_COUNT_HW_CACHE_REFERENCES,
+    [PERF_CACHE_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+    [PERF_BRANCHES] = PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+    [PERF_BRANCH_MISSES] = PERF_COUNT_HW_BRANCH_MISSES,
+};
+#endif
+
+bool perf_open(PerfCounters* pc) {
+    bool any = false;
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        pc->fds[i] = -1;
+#ifdef __linux__
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = perf_event_configs[i];
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Events are opened separately (not as a group) so that inherit works
+        // and a PMU with few counters can still multiplex them
+        pc->fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (pc->fds[i] >= 0) any = true;
+#endif
+    }
+    return any;
+}
+
+void perf_close(PerfCounters* pc) {
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] >= 0) close(pc->fds[i]);
+        pc->fds[i] = -1;
+    }
+}
+
+void perf_start(PerfCounters* pc) {
+#ifdef __linux__
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] < 0) continue;
+        ioctl(pc->fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(pc->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)pc;
+#endif
+}
+
+PerfCounts perf_stop(PerfCounters* pc) {
+    PerfCounts counts = {0};
+#ifdef __linux__
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] < 0) continue;
+        ioctl(pc->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        // value, time enabled, time running; scale up if multiplexed
+        uint64_t buf[3];
+        if (read(pc->fds[i], buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0) continue;
+        counts.values[i] = (uint64_t)((double)buf[0] * buf[1] / buf[2]);
+        counts.valid[i] = true;
+    }
+#else
+    (void)pc;
+#endif
+    return counts;
+}
+
+static size_t u64map_hash(const U64Map* map, uint64_t key) {
+    // Fibonacci hashing: the top bits of key * 2^64/phi
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> map->shift);
+}
+
+static void u64map_alloc(U64Map* map, size_t capacity) {
+    size_t dense = capacity / 2;
+    map->capacity = capacity;
+    map->shift = 64 - __builtin_ctzll(capacity);
+    map->index = calloc(capacity, sizeof(uint32_t));
+    map->keys = realloc(map->keys, dense * sizeof(uint64_t));
+    map->values = realloc(map->values, dense * sizeof(int64_t));
+    map->slots = realloc(map->slots, dense * sizeof(uint32_t));
+}
+
+void u64map_init(U64Map* map, size_t expected) {
+    size_t capacity = 16;
+    while (capacity / 2 < expected) capacity *= 2;
+
+    map->keys = NULL;
+    map->values = NULL;
+    map->slots = NULL;
+    map->count = 0;
+    u64map_alloc(map, capacity);
+}
+
+void u64map_destroy(U64Map* map) {
+    free(map->index);
+    free(map->keys);
+    free(map->values);
+    free(map->slots);
+    map->index = NULL;
+    map->keys = NULL;
+    map->values = NULL;
+    map->slots = NULL;
+    map->count = 0;
+}
+
+void u64map_clear(U64Map* map) {
+    for (size_t i = 0; i < map->count; i++) {
+        map->index[map->slots[i]] = 0;
+    }
+    map->count = 0;
+}
+
+// Slot holding key, or the empty slot where it would go
+static size_t u64map_find(const U64Map* map, uint64_t key) {
+    size_t mask = map->capacity - 1;
+    size_t slot = u64map_hash(map, key);
+    while (map->index[slot] != 0 && map->keys[map->index[slot] - 1] != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static void u64map_grow(U64Map* map) {
+    free(map->index);
+    u64map_alloc(map, map->capacity * 2);
+    for (size_t i = 0; i < map->count; i++) {
+        size_t slot = u64map_find(map, map->keys[i]);
+        map->index[slot] = (uint32_t)(i + 1);
+        map->slots[i] = (uint32_t)slot;
+    }
+}
+
+bool u64map_contains(const U64Map* map, uint64_t key) {
+    return map->index[u64map_find(map, key)] != 0;
 }
 
-void free_lines(char** lines, int count) {
-    if (!lines) return;
+int64_t* u64map_get(U64Map* map, uint64_t key) {
+    size_t slot = u64map_find(map, key);
+    if (map->index[slot] != 0) return &map->values[map->index[slot] - 1];
+
+    if (map->count + 1 > map->capacity / 2) {
+        u64map_grow(map);
+        slot = u64map_find(map, key);
+    }
+
+    size_t i = map->count++;
+    map->keys[i] = key;
+    map->values[i] = 0;
+    map->slots[i] = (uint32_t)slot;
+    map->index[slot] = (uint32_t)(i + 1);
+    return &map->values[i];
+}
+
+bool u64map_insert(U64Map* map, uint64_t key) {
+    size_t before = map->count;
+    u64map_get(map, key);
+    return map->count > before;
+}
+
+static int compare_intervals(const void* a, const void* b) {
+    const Interval* ia = a;
+    const Interval* ib = b;
+    if (ia->start < ib->start) return -1;
+    if (ia->start > ib->start) return 1;
+    return 0;
+}
+
+void interval_index_build(IntervalIndex* index, const Interval* ranges, int count) {
+    Interval* sorted = malloc((count > 0 ? count : 1) * sizeof(Interval));
+    if (count > 0) memcpy(sorted, ranges, count * sizeof(Interval));
+    qsort(sorted, count, sizeof(Interval), compare_intervals);
+
+    index->starts = malloc((count > 0 ? count : 1) * sizeof(int64_t));
+    index->ends = malloc((count > 0 ? count : 1) * sizeof(int64_t));
+    index->count = 0;
+    index->file = (InputView){0};
+
+    // Merge overlapping and adjacent ranges
     for (int i = 0; i < count; i++) {
-        free(lines[i]);
+        int last = index->count - 1;
+        if (last >= 0 && sorted[i].start <= index->ends[last] + 1) {
+            if (sorted[i].end > index->ends[last]) index->ends[last] = sorted[i].end;
+        } else {
+            index->starts[index->count] = sorted[i].start;
+            index->ends[index->count] = sorted[i].end;
+            index->count++;
+        }
+    }
+
+    free(sorted);
+}
+
+void interval_index_destroy(IntervalIndex* index) {
+    if (index->file.data) {
+        unmap_file(&index->file);
+    } else {
+        free(index->starts);
+        free(index->ends);
+    }
+    index->starts = NULL;
+    index->ends = NULL;
+    index->count = 0;
+}
+
+bool interval_index_contains(const IntervalIndex* index, int64_t value) {
+    const int64_t* base = index->starts;
+    int n = index->count;
+    if (n == 0 || value < base[0]) return false;
+
+    // Last start <= value; the halving compiles to a conditional move
+    while (n > 1) {
+        int half = n / 2;
+        base = base[half] <= value ? base + half : base;
+        n -= half;
+    }
+    return value <= index->ends[base - index->starts];
+}
+
+// First run at or after from that ends at value - 1 or later, i.e. the
+// first one that a range starting at value could touch
+static int first_run_reaching(const IntervalIndex* index, int from, int64_t value) {
+    int lo = from, hi = index->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (index->ends[mid] < value - 1) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+bool interval_index_add(IntervalIndex* index, const Interval* ranges, int count) {
+    IntervalIndex added;
+    interval_index_build(&added, ranges, count);
+
+    int n = index->count;
+    int64_t* starts = malloc((n + added.count > 0 ? n + added.count : 1) * sizeof(int64_t));
+    int64_t* ends = malloc((n + added.count > 0 ? n + added.count : 1) * sizeof(int64_t));
+    int out = 0;
+    int next = 0;           // first old run not copied or merged yet
+    bool changed = false;
+
+    for (int i = 0; i < added.count; i++) {
+        int64_t start = added.starts[i];
+        int64_t end = added.ends[i];
+
+        // Old runs entirely before this one are copied unchanged
+        int first = first_run_reaching(index, next, start);
+        memcpy(starts + out, index->starts + next, (first - next) * sizeof(int64_t));
+        memcpy(ends + out, index->ends + next, (first - next) * sizeof(int64_t));
+        out += first - next;
+
+        if (first < n && index->starts[first] <= start && end <= index->ends[first]) {
+            // Already covered; the old run is copied with the next block
+            next = first;
+            continue;
+        }
+        changed = true;
+
+        // Absorb the old runs it overlaps or touches
+        int j = first;
+        for (; j < n && index->starts[j] <= end + 1; j++) {
+            if (index->starts[j] < start) start = index->starts[j];
+            if (index->ends[j] > end) end = index->ends[j];
+        }
+        next = j;
+
+        // Absorbing may have stretched the previous output run into this one
+        if (out > 0 && start <= ends[out - 1] + 1) {
+            if (end > ends[out - 1]) ends[out - 1] = end;
+        } else {
+            starts[out] = start;
+            ends[out] = end;
+            out++;
+        }
+    }
+
+    memcpy(starts + out, index->starts + next, (n - next) * sizeof(int64_t));
+    memcpy(ends + out, index->ends + next, (n - next) * sizeof(int64_t));
+    out += n - next;
+
+    interval_index_destroy(&added);
+    interval_index_destroy(index);
+    index->starts = starts;
+    index->ends = ends;
+    index->count = out;
+    return changed;
+}
+
+#define INDEX_MAGIC "AOCRIDX1"
+
+typedef struct {
+    char magic[8];
+    uint64_t count;
+} IndexHeader;
+
+bool interval_index_save(const IntervalIndex* index, const char* path) {
+    size_t path_len = strlen(path);
+    char* temp = malloc(path_len + sizeof(".XXXXXX"));
+    memcpy(temp, path, path_len);
+    memcpy(temp + path_len, ".XXXXXX", sizeof(".XXXXXX"));
+
+    int fd = mkstemp(temp);
+    if (fd >= 0) fchmod(fd, 0644);      // mkstemp creates it owner-only
+    FILE* f = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (!f) {
+        if (fd >= 0) close(fd);
+        fprintf(stderr, "Cannot write file: %s\n", path);
+        free(temp);
+        return false;
+    }
+
+    IndexHeader header = { .count = (uint64_t)index->count };
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(index->starts, sizeof(int64_t), index->count, f) == (size_t)index->count &&
+              fwrite(index->ends, sizeof(int64_t), index->count, f) == (size_t)index->count;
+    ok = fclose(f) == 0 && ok;
+    ok = ok && rename(temp, path) == 0;
+    if (!ok) {
+        unlink(temp);
+        fprintf(stderr, "Cannot write file: %s\n", path);
+    }
+
+    free(temp);
+    return ok;
+}
+
+bool interval_index_load(IntervalIndex* index, const char* path) {
+    InputView file = map_file(path);
+    if (!file.data) return false;
+
+    IndexHeader header = {0};
+    if (file.len >= sizeof(header)) memcpy(&header, file.data, sizeof(header));
+    if (file.len < sizeof(header) ||
+        memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+        header.count > INT_MAX ||
+        file.len != sizeof(header) + header.count * 2 * sizeof(int64_t)) {
+        fprintf(stderr, "Not a range index: %s\n", path);
+        unmap_file(&file);
+        return false;
+    }
+
+    // The header keeps the arrays 8-byte aligned in the page-aligned mapping
+    index->file = file;
+    index->count = (int)header.count;
+    index->starts = (int64_t*)(file.data + sizeof(header));
+    index->ends = index->starts + header.count;
+    return true;
+}
+
+int64_t interval_index_total(const IntervalIndex* index) {
+    int64_t total = 0;
+    for (int i = 0; i < index->count; i++) {
+        total += index->ends[i] - index->starts[i] + 1;
+    }
+    return total;
+}
+
+int64_t interval_index_count_sorted(const IntervalIndex* index, const int64_t* values, size_t n) {
+    int64_t count = 0;
+    int run = 0;
+    for (size_t i = 0; i < n && run < index->count; i++) {
+        while (run < index->count && index->ends[run] < values[i]) run++;
+        count += run < index->count && values[i] >= index->starts[run];
+    }
+    return count;
+}
+
+#define RADIX_BITS 11
+#define RADIX_DIGITS ((64 + RADIX_BITS - 1) / RADIX_BITS)
+
+void radix_sort_i64(int64_t* keys, size_t n, int64_t* scratch) {
+    // Flipping the sign bit makes signed order match unsigned digit order
+    const uint64_t flip = 1ULL << 63;
+    const uint64_t mask = (1u << RADIX_BITS) - 1;
+    size_t (*counts)[1 << RADIX_BITS] = calloc(RADIX_DIGITS, sizeof(*counts));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = (uint64_t)keys[i] ^ flip;
+        for (int d = 0; d < RADIX_DIGITS; d++) {
+            counts[d][key >> (RADIX_BITS * d) & mask]++;
+        }
+    }
+
+    int64_t* from = keys;
+    int64_t* to = scratch;
+    for (int d = 0; d < RADIX_DIGITS; d++) {
+        int shift = RADIX_BITS * d;
+        if (n == 0 || counts[d][((uint64_t)from[0] ^ flip) >> shift & mask] == n) continue;
+
+        // Prefix sums turn the counts into output positions
+        size_t sum = 0;
+        for (uint64_t v = 0; v <= mask; v++) {
+            size_t c = counts[d][v];
+            counts[d][v] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            to[counts[d][((uint64_t)from[i] ^ flip) >> shift & mask]++] = from[i];
+        }
+
+        int64_t* tmp = from;
+        from = to;
+        to = tmp;
+    }
+
+    if (from != keys) memcpy(keys, from, n * sizeof(int64_t));
+    free(counts);
+}
+
+// Atomic because day workers under --jobs may resolve it concurrently;
+// a racing first call just stores the same CPU count twice
+static atomic_int parallel_thread_count = 0;   // 0 = not set yet
+
+int parallel_threads(void) {
+    int count = atomic_load_explicit(&parallel_thread_count, memory_order_relaxed);
+    if (count <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        count = cpus > 0 ? (int)cpus : 1;
+        atomic_store_explicit(&parallel_thread_count, count, memory_order_relaxed);
+    }
+    return count;
+}
+
+void parallel_set_threads(int n) {
+    atomic_store_explicit(&parallel_thread_count, n, memory_order_relaxed);
+}
+
+static atomic_int fast_path_mode = FAST_PATHS_AUTO;
+
+bool fast_path(int64_t n, int64_t threshold) {
+    switch (atomic_load_explicit(&fast_path_mode, memory_order_relaxed)) {
+    case FAST_PATHS_ON:
+        return n > 0;
+    case FAST_PATHS_OFF:
+        return false;
+    default:
+        return n >= threshold;
+    }
+}
+
+void fast_path_set_mode(FastPathMode mode) {
+    atomic_store_explicit(&fast_path_mode, mode, memory_order_relaxed);
+}
+
+typedef struct {
+    void (*fn)(void* ctx, int i);
+    void* ctx;
+    int n;
+    atomic_int next;
+} ParallelJob;
+
+static void* parallel_worker(void* arg) {
+    ParallelJob* job = arg;
+    for (;;) {
+        int i = atomic_fetch_add(&job->next, 1);
+        if (i >= job->n) break;
+        job->fn(job->ctx, i);
+    }
+    return NULL;
+}
+
+void parallel_for(int n, void (*fn)(void* ctx, int i), void* ctx) {
+    int threads = parallel_threads();
+    if (threads > n) threads = n;
+    if (threads <= 1) {
+        for (int i = 0; i < n; i++) fn(ctx, i);
+        return;
+    }
+
+    ParallelJob job = { .fn = fn, .ctx = ctx, .n = n };
+    atomic_init(&job.next, 0);
+
+    // If a thread can't be created the others just take more of the work
+    pthread_t* tids = malloc((threads - 1) * sizeof(pthread_t));
+    int created = 0;
+    for (int t = 0; t < threads - 1; t++) {
+        if (pthread_create(&tids[created], NULL, parallel_worker, &job) == 0) created++;
     }
-    free(lines);
+    parallel_worker(&job);
+    for (int t = 0; t < created; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    free(tids);
+}
+
+char* format_u128(u128 value, char* buf) {
+    char digits[40];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + (int)(value % 10));
+        value /= 10;
+    } while (value);
+
+    for (int i = 0; i < n; i++) {
+        buf[i] = digits[n - 1 - i];
+    }
+    buf[n] = '\0';
+    return buf;
+}
+
+typedef struct {
+    void (*fn)(void* ctx, int i, Arena* scratch, int64_t* sums);
+    void* ctx;
+    int n;
+    int width;
+    int batch;
+    atomic_int next;
+    int64_t* partials;      // width sums per worker
+} SumJob;
+
+static void sum_worker(void* arg, int w) {
+    SumJob* job = arg;
+    int64_t* sums = &job->partials[(size_t)w * job->width];
+    Arena scratch;
+    arena_init(&scratch);
+
+    for (;;) {
+        int begin = atomic_fetch_add(&job->next, job->batch);
+        if (begin >= job->n) break;
+        int end = begin + job->batch < job->n ? begin + job->batch : job->n;
+        for (int i = begin; i < end; i++) {
+            job->fn(job->ctx, i, &scratch, sums);
+        }
+    }
+
+    arena_destroy(&scratch);
+}
+
+void parallel_sum(int n, int grain, int width,
+                  void (*fn)(void* ctx, int i, Arena* scratch, int64_t* sums),
+                  void* ctx, int64_t* totals) {
+    for (int j = 0; j < width; j++) totals[j] = 0;
+    if (n <= 0) return;
+    if (grain < 1) grain = 1;
+
+    // No more workers than there are grains of work; batches are small
+    // enough that uneven items still balance out
+    int workers = parallel_threads();
+    if (workers > (n + grain - 1) / grain) workers = (n + grain - 1) / grain;
+    int batch = n / (workers * 16);
+    if (batch < grain) batch = grain;
+
+    SumJob job = {
+        .fn = fn,
+        .ctx = ctx,
+        .n = n,
+        .width = width,
+        .batch = batch,
+        .partials = calloc((size_t)workers * width, sizeof(int64_t)),
+    };
+    atomic_init(&job.next, 0);
+    parallel_for(workers, sum_worker, &job);
+
+    // Reduce in worker order
+    for (int w = 0; w < workers; w++) {
+        for (int j = 0; j < width; j++) {
+            totals[j] += job.partials[(size_t)w * width + j];
+        }
+    }
+    free(job.partials);
+}
+
+int64_t clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void stopwatch_start(Stopwatch* sw) {
+    sw->last_ns = clock_ns();
+}
+
+void stopwatch_lap(Stopwatch* sw, double* slot_ms) {
+    int64_t now = clock_ns();
+    *slot_ms += (double)(now - sw->last_ns) / 1e6;
+    sw->last_ns = now;
+}
+
+DayResult run_solver(const DaySolver* solver, const char* input, size_t len, Arena* arena) {
+    DayResult result = {0};
+    Stopwatch sw;
+    stopwatch_start(&sw);
+
+    void* data = solver->parse(input, len, arena);
+    stopwatch_lap(&sw, &result.timings.parse_ms);
+
+    result.part1 = solver->part1(data, arena);
+    stopwatch_lap(&sw, &result.timings.part1_ms);
+
+    result.part2 = solver->part2(data, arena);
+    stopwatch_lap(&sw, &result.timings.part2_ms);
+
+    solver->free(data);
+    arena_reset(arena);
+    return result;
 }
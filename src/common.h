@@ -10,34 +10,292 @@
 #include <limits.h>
 #include <time.h>
 
-// Read entire file into a string (caller must free)
-char* read_file(const char* filename);
+// Unsigned 128-bit integer for sums that can outgrow 64 bits
+__extension__ typedef unsigned __int128 u128;
 
-// Read input file for a specific day
-char* read_input(int day);
+// Decimal digits of value in buf (at least 40 bytes); returns buf
+char* format_u128(u128 value, char* buf);
 
-// Read example file for a specific day
-char* read_example(int day);
+// Read-only view of an input file. The file is memory-mapped when possible
+// (otherwise read into a heap buffer); data[len] is always '\0', so the
+// view can also be used as a C string. data is NULL if the file can't be read.
+typedef struct {
+    const char* data;
+    size_t len;
+    size_t map_len;     // 0 when data is a heap buffer
+} InputView;
+
+// Map a file into memory (release with unmap_file)
+InputView map_file(const char* filename);
+
+// Release a view returned by map_file or the read_* helpers
+void unmap_file(InputView* view);
+
+// Map input file for a specific day
+InputView read_input(int day);
+
+// Map example file for a specific day
+InputView read_example(int day);
+
+// Map custom file for a specific day
+InputView read_as_string(int day, const char* name);
+
+// Read the expected answers for a day's input from inputs/NN-<name>.answer
+// (part 1 then part 2, whitespace separated); false if missing or malformed
+bool read_answers(int day, const char* name, int64_t* part1, int64_t* part2);
+
+// A line inside the input buffer, without its '\n' (not NUL-terminated)
+typedef struct {
+    const char* ptr;
+    int len;
+} Span;
+
+// Line iterator over an input buffer. Trailing empty lines are skipped;
+// empty lines in the middle are returned with len 0.
+typedef struct {
+    const char* cur;
+    const char* end;
+} LineIter;
+
+LineIter lines_begin(const char* input, size_t len);
+bool lines_next(LineIter* it, Span* line);
+
+// Utility: collect all lines as spans into the input (caller frees the array)
+Span* collect_lines(const char* input, size_t len, int* count);
+
+// Line reader over a file descriptor (file, pipe, stdin) that reads in
+// chunks into a fixed buffer, so memory use doesn't depend on input size.
+// Lines longer than the buffer are returned in buffer-sized pieces.
+#define LINE_STREAM_BUFFER (64 * 1024)
+
+typedef struct {
+    int fd;
+    size_t start;       // first unread byte in buf
+    size_t end;         // end of valid data in buf
+    bool eof;
+    char buf[LINE_STREAM_BUFFER];
+} LineStream;
+
+void line_stream_init(LineStream* s, int fd);
+
+// Next line without its '\n'; the span is valid until the next call.
+// Unlike LineIter, trailing empty lines are returned too.
+bool line_stream_next(LineStream* s, Span* line);
+
+// Vectorized scanners (AVX2 or SSE2 when the build targets them, scalar
+// otherwise). They never read outside [p, end).
+
+// First occurrence of c in [p, end), or end if there is none
+const char* scan_byte(const char* p, const char* end, char c);
+
+// Skip to the next digit in [*p, end) and parse the unsigned decimal number
+// starting there, leaving *p just past it. Any non-digit separates fields
+// ("12-34", "1,2,3", "4x4: 0 2"). Returns false if no digits are left or
+// the number doesn't fit in the result type: scan_uint fails past
+// UINT64_MAX and scan_int, the same for int, past INT_MAX.
+bool scan_uint(const char** p, const char* end, uint64_t* value);
+bool scan_int(const char** p, const char* end, int* value);
+
+// Signed variant: a '-' directly before the digits makes the number
+// negative ("-3,4" is -3 and 4, so don't use it on "12-34" ranges).
+// Fails on values outside int64_t, like the unsigned scanners.
+bool scan_i64(const char** p, const char* end, int64_t* value);
+
+// Bump allocator for solver scratch memory. Blocks are never freed one by
+// one; everything is released at once by arena_reset (or back to a mark).
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock* first;
+    ArenaBlock* current;
+    size_t used;            // bytes used in current
+} Arena;
+
+// Position in an arena, for releasing nested scratch (e.g. per recursion step)
+typedef struct {
+    ArenaBlock* block;
+    size_t used;
+} ArenaMark;
+
+void arena_init(Arena* arena);
+void arena_destroy(Arena* arena);
+
+// Release all allocations, keeping the memory for reuse
+void arena_reset(Arena* arena);
+
+// 16-byte aligned allocation; arena_calloc also zeroes it
+void* arena_alloc(Arena* arena, size_t size);
+void* arena_calloc(Arena* arena, size_t count, size_t size);
+
+ArenaMark arena_mark(Arena* arena);
+void arena_release(Arena* arena, ArenaMark mark);
+
+// Open-addressing hash map from uint64 keys to int64 values, also used as
+// a set. Linear probing over a power-of-two index that grows at half load;
+// entries live in dense arrays in insertion order, so iteration and clear
+// cost O(count) rather than O(capacity), and inserts never allocate per key.
+// Iterate with keys[i] / values[i] for i < count.
+typedef struct {
+    uint32_t* index;        // 0 = empty, else 1 + position in the dense arrays
+    uint64_t* keys;
+    int64_t* values;
+    uint32_t* slots;        // index slot of each dense entry
+    size_t count;
+    size_t capacity;        // index size (power of two)
+    int shift;              // 64 - log2(capacity)
+} U64Map;
+
+void u64map_init(U64Map* map, size_t expected);
+void u64map_destroy(U64Map* map);
+void u64map_clear(U64Map* map);
+
+bool u64map_contains(const U64Map* map, uint64_t key);
+
+// Value for key, inserted as 0 if absent (valid until the next insert)
+int64_t* u64map_get(U64Map* map, uint64_t key);
+
+// Set insert: true if the key was not present yet
+bool u64map_insert(U64Map* map, uint64_t key);
+
+// Closed interval [start, end]
+typedef struct {
+    int64_t start;
+    int64_t end;
+} Interval;
+
+// Membership index over a set of intervals. Built once from any ranges
+// (overlapping, adjacent, unsorted): they are sorted and merged into
+// disjoint runs kept as separate start and end arrays, so a lookup is a
+// branchless binary search over the starts and one compare with an end.
+typedef struct {
+    int64_t* starts;
+    int64_t* ends;
+    int count;
+    InputView file;         // mapping the arrays live in, if loaded from a file
+} IntervalIndex;
+
+void interval_index_build(IntervalIndex* index, const Interval* ranges, int count);
+void interval_index_destroy(IntervalIndex* index);
+
+// Merge more ranges into the index. Runs the new ranges don't touch are
+// copied over in blocks; only the overlapping or adjacent ones are merged.
+// Returns false if the ranges were all covered already (nothing changed).
+bool interval_index_add(IntervalIndex* index, const Interval* ranges, int count);
+
+// Index files hold a 16-byte header ("AOCRIDX1" and the run count) and
+// then the start and end arrays, in native byte order, so a loaded index
+// maps the file and uses the arrays in place. Saving writes a temporary
+// file next to path and renames it over, so readers never see half a file.
+bool interval_index_save(const IntervalIndex* index, const char* path);
+
+// False (with a message) if the file can't be read or is not a valid index
+bool interval_index_load(IntervalIndex* index, const char* path);
+
+bool interval_index_contains(const IntervalIndex* index, int64_t value);
+
+// Number of integers covered by the index
+int64_t interval_index_total(const IntervalIndex* index);
+
+// How many of the ascending values lie in the index, in one merge sweep
+// over values and runs (duplicates count each time, like per-value lookups)
+int64_t interval_index_count_sorted(const IntervalIndex* index, const int64_t* values, size_t n);
 
-// Read custom file for a specific day
-char* read_as_string(int day, const char* name);
+// LSD radix sort, 11 bits per pass; passes where every key has the same
+// digit are skipped, so small keys take fewer passes. scratch holds n keys.
+void radix_sort_i64(int64_t* keys, size_t n, int64_t* scratch);
 
-// Utility: count lines in a string
-int count_lines(const char* str);
+// Fork-join data parallelism for solvers: runs fn(ctx, i) for i in [0, n)
+// on up to parallel_threads() threads (the caller is one of them) and
+// returns when all calls are done. Calls may run in any order.
+void parallel_for(int n, void (*fn)(void* ctx, int i), void* ctx);
 
-// Utility: split string by delimiter, returns array of strings (caller must free)
-char** split_lines(const char* str, int* count);
+// Parallel map-reduce over n independent items (lines, machines, ...):
+// fn(ctx, i, scratch, sums) adds item i's contribution to sums[0, width),
+// and totals gets the element-wise sum over all items. Workers take
+// batches of at least grain items, so cheap items can be batched up, and
+// each worker has its own scratch arena, released after its last batch.
+void parallel_sum(int n, int grain, int width,
+                  void (*fn)(void* ctx, int i, Arena* scratch, int64_t* sums),
+                  void* ctx, int64_t* totals);
 
-// Utility: free array of strings
-void free_lines(char** lines, int count);
+// Threads parallel_for may use; defaults to the number of online CPUs
+int parallel_threads(void);
+void parallel_set_threads(int n);
 
-// Day solver function type
+// Solvers switch to parallel or sorted variants once an input reaches a
+// size threshold, which the real inputs mostly don't. FAST_PATHS_ON and
+// FAST_PATHS_OFF force every such switch one way for any non-empty input,
+// so make check can run both variants on small inputs.
+typedef enum { FAST_PATHS_AUTO, FAST_PATHS_ON, FAST_PATHS_OFF } FastPathMode;
+
+// True if the variant gated at threshold should run for an input of size n
+bool fast_path(int64_t n, int64_t threshold);
+void fast_path_set_mode(FastPathMode mode);
+
+// Monotonic wall clock in nanoseconds
+int64_t clock_ns(void);
+
+// Phase stopwatch: each lap adds the time since the previous lap to a slot
+typedef struct {
+    int64_t last_ns;
+} Stopwatch;
+
+void stopwatch_start(Stopwatch* sw);
+void stopwatch_lap(Stopwatch* sw, double* slot_ms);
+
+// Hardware performance counters (Linux perf_event_open). Counters are
+// per thread and include threads the counting thread spawns.
+enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_REFS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCHES,
+    PERF_BRANCH_MISSES,
+    PERF_NUM_EVENTS
+};
+
+typedef struct {
+    uint64_t values[PERF_NUM_EVENTS];
+    bool valid[PERF_NUM_EVENTS];
+} PerfCounts;
+
+typedef struct {
+    int fds[PERF_NUM_EVENTS];
+} PerfCounters;
+
+// Open counters for the calling thread; false if none are available
+bool perf_open(PerfCounters* pc);
+void perf_close(PerfCounters* pc);
+void perf_start(PerfCounters* pc);
+PerfCounts perf_stop(PerfCounters* pc);
+
+// Wall-clock time spent in each phase of a solver, in milliseconds
+typedef struct {
+    double parse_ms;
+    double part1_ms;
+    double part2_ms;
+} DayTimings;
+
+// Day solver result
 typedef struct {
     int64_t part1;
     int64_t part2;
+    DayTimings timings;
 } DayResult;
 
-// Function pointer type for day solvers
-typedef DayResult (*DaySolver)(const char* input);
+// Day solver pipeline: the input is parsed once and the parsed data is
+// handed to both parts. part1 always runs before part2, so a part may
+// modify the data or cache work in it for the next part. Every phase gets
+// the same scratch arena, which is reset after the run.
+typedef struct {
+    void* (*parse)(const char* input, size_t len, Arena* arena);
+    int64_t (*part1)(void* data, Arena* arena);
+    int64_t (*part2)(void* data, Arena* arena);
+    void (*free)(void* data);
+} DaySolver;
+
+// Run parse -> part1 -> part2 on an input, timing each phase
+DayResult run_solver(const DaySolver* solver, const char* input, size_t len, Arena* arena);
 
 #endif // COMMON_H
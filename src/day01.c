@@ -15,87 +15,241 @@ static int mod(int n, int m) {
     return ((n % m) + m) % m;
 }
 
-static Instruction* parse_input(const char* input, int* count) {
-    int line_count;
-    char** lines = split_lines(input, &line_count);
+typedef struct {
+    Instruction* items;
+    int count;
+} InstructionList;
+
+// Dial position plus both parts' zero counts, updated one instruction at a time
+typedef struct {
+    int position;
+    int64_t landed;     // part 1: turns ending on 0
+    int64_t passed;     // part 2: clicks passing or landing on 0
+} Dial;
+
+static Dial dial_start(void) {
+    return (Dial){ .position = 50 };
+}
 
-    Instruction* instructions = malloc(line_count * sizeof(Instruction));
-    *count = 0;
+static void dial_turn(Dial* dial, int sign, int steps) {
+    int position = dial->position;
 
-    for (int i = 0; i < line_count; i++) {
-        if (lines[i][0] == '\0') continue;
+    // Each full rotation crosses 0 once
+    dial->passed += steps / DIAL_SIZE;
 
-        instructions[*count].sign = (lines[i][0] == 'R') ? 1 : -1;
-        instructions[*count].steps = atoi(lines[i] + 1);
-        (*count)++;
+    int remainder = steps % DIAL_SIZE;
+    int new_position = mod(position + sign * remainder, DIAL_SIZE);
+
+    // Check if we crossed 0 (not counting starting from 0)
+    bool crossed = false;
+    if (position != 0) {
+        if (sign > 0) {
+            crossed = (position + remainder >= DIAL_SIZE);
+        } else {
+            crossed = (position < remainder);
+        }
     }
 
-    free_lines(lines, line_count);
-    return instructions;
-}
+    // Landing on 0 counts (but not if we started from 0 and didn't move)
+    bool landed_on_zero = (new_position == 0) && (position != 0 || remainder > 0);
 
-static int64_t part_one(const char* input) {
-    int count;
-    Instruction* instructions = parse_input(input, &count);
+    if (crossed || landed_on_zero) {
+        dial->passed++;
+    }
+    if (new_position == 0) {
+        dial->landed++;
+    }
 
-    int position = 50;
-    int result = 0;
+    dial->position = new_position;
+}
 
-    for (int i = 0; i < count; i++) {
-        position = mod(position + instructions[i].sign * instructions[i].steps, DIAL_SIZE);
-        if (position == 0) {
-            result++;
+// "R8" / "L29"; false for lines without a rotation
+static bool parse_instruction(Span line, Instruction* ins) {
+    const char* p = line.ptr;
+    if (line.len == 0 || !scan_int(&p, line.ptr + line.len, &ins->steps)) return false;
+    ins->sign = (line.ptr[0] == 'R') ? 1 : -1;
+    return true;
+}
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    int capacity = 1024;
+    InstructionList* list = malloc(sizeof(InstructionList));
+    list->items = malloc(capacity * sizeof(Instruction));
+    list->count = 0;
+
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line)) {
+        if (list->count >= capacity) {
+            capacity *= 2;
+            list->items = realloc(list->items, capacity * sizeof(Instruction));
+        }
+        if (parse_instruction(line, &list->items[list->count])) {
+            list->count++;
         }
     }
 
-    free(instructions);
-    return result;
+    return list;
 }
 
-static int64_t part_two(const char* input) {
-    int count;
-    Instruction* instructions = parse_input(input, &count);
+static void free_input(void* data) {
+    InstructionList* list = data;
+    free(list->items);
+    free(list);
+}
+
+// Above this many instructions the dial is evaluated as a parallel scan
+#define PARALLEL_MIN_INSTRUCTIONS (1 << 16)
 
-    int position = 50;
-    int result = 0;
+// Effect of a run of instructions as a function of the start position p:
+// the dial moves by shift and hits zero landed[p] / passed[p] times
+typedef struct {
+    int shift;
+    int64_t landed[DIAL_SIZE];
+    int64_t passed[DIAL_SIZE];
+} ChunkSummary;
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if (a % b != 0 && (a < 0) != (b < 0)) q--;
+    return q;
+}
 
+// Summarize a chunk for all 100 start positions in one pass. With the
+// unwrapped position P_i = p + S_i (S_i the prefix sum of signed steps),
+// a move hits the multiples of 100 in (P_{i-1}, P_i] going right and in
+// [P_i, P_{i-1}) going left:
+//   right: floor(P_i / 100) - floor(P_{i-1} / 100)
+//   left:  floor((P_{i-1} - 1) / 100) - floor((P_i - 1) / 100)
+// Writing S_i = 100 q_i + r_i, floor((p + S_i) / 100) = q_i + [p >= 100 - r_i]
+// and floor((p + S_i - 1) / 100) = q_i + [p >= 101 - r_i] - [p + r_i == 0].
+// The q terms sum to a constant and the step functions of p go into a
+// difference array.
+static void summarize_chunk(const Instruction* items, int count, ChunkSummary* out) {
+    int64_t landings[DIAL_SIZE] = {0};      // by S_i mod 100
+    int64_t diff[DIAL_SIZE] = {0};
+    int64_t base = 0;
+    int64_t at_zero = 0;                    // extra hits when p == 0
+
+    int64_t sum = 0, q = 0;
+    int r = 0;
     for (int i = 0; i < count; i++) {
-        int sign = instructions[i].sign;
-        int steps = instructions[i].steps;
-
-        // Each full rotation crosses 0 once
-        result += steps / DIAL_SIZE;
-
-        int remainder = steps % DIAL_SIZE;
-        int new_position = mod(position + sign * remainder, DIAL_SIZE);
-
-        // Check if we crossed 0 (not counting starting from 0)
-        bool crossed = false;
-        if (position != 0) {
-            if (sign > 0) {
-                crossed = (position + remainder >= DIAL_SIZE);
-            } else {
-                crossed = (position < remainder);
-            }
+        int sign = items[i].sign;
+        int64_t next_sum = sum + (int64_t)sign * items[i].steps;
+        int64_t next_q = floor_div(next_sum, DIAL_SIZE);
+        int next_r = (int)(next_sum - next_q * DIAL_SIZE);
+
+        landings[next_r]++;
+        if (sign > 0) {
+            base += next_q - q;
+            if (next_r > 0) diff[DIAL_SIZE - next_r]++;
+            if (r > 0) diff[DIAL_SIZE - r]--;
+        } else {
+            base += q - next_q;
+            if (r > 1) diff[DIAL_SIZE + 1 - r]++;
+            if (next_r > 1) diff[DIAL_SIZE + 1 - next_r]--;
+            if (r == 0) at_zero--;
+            if (next_r == 0) at_zero++;
         }
 
-        // Landing on 0 counts (but not if we started from 0 and didn't move)
-        bool landed_on_zero = (new_position == 0) && (position != 0 || remainder > 0);
+        sum = next_sum;
+        q = next_q;
+        r = next_r;
+    }
+
+    out->shift = r;
+    int64_t steps = 0;
+    for (int p = 0; p < DIAL_SIZE; p++) {
+        steps += diff[p];
+        out->landed[p] = landings[(DIAL_SIZE - p) % DIAL_SIZE];
+        out->passed[p] = base + steps + (p == 0 ? at_zero : 0);
+    }
+}
 
-        if (crossed || landed_on_zero) {
-            result++;
+typedef struct {
+    const InstructionList* list;
+    int chunk_size;
+    ChunkSummary* summaries;
+} ScanJob;
+
+static void scan_chunk(void* ctx, int c) {
+    ScanJob* job = ctx;
+    int begin = c * job->chunk_size;
+    int end = begin + job->chunk_size;
+    if (end > job->list->count) end = job->list->count;
+    summarize_chunk(job->list->items + begin, end - begin, &job->summaries[c]);
+}
+
+// Both parts' counts over the whole list: chunks are summarized in
+// parallel, then chained from the start position in order
+static Dial run_dial(const InstructionList* list, Arena* arena) {
+    Dial dial = dial_start();
+    if (!fast_path(list->count, PARALLEL_MIN_INSTRUCTIONS)) {
+        for (int i = 0; i < list->count; i++) {
+            dial_turn(&dial, list->items[i].sign, list->items[i].steps);
         }
+        return dial;
+    }
 
-        position = new_position;
+    // A few chunks per thread so uneven thread start-up evens out
+    int chunks = parallel_threads() * 4;
+    ScanJob job = {
+        .list = list,
+        .chunk_size = (list->count + chunks - 1) / chunks,
+        .summaries = arena_alloc(arena, chunks * sizeof(ChunkSummary)),
+    };
+    chunks = (list->count + job.chunk_size - 1) / job.chunk_size;
+    parallel_for(chunks, scan_chunk, &job);
+
+    for (int c = 0; c < chunks; c++) {
+        const ChunkSummary* s = &job.summaries[c];
+        dial.landed += s->landed[dial.position];
+        dial.passed += s->passed[dial.position];
+        dial.position = (dial.position + s->shift) % DIAL_SIZE;
     }
+    return dial;
+}
 
-    free(instructions);
-    return result;
+static int64_t part_one(void* data, Arena* arena) {
+    InstructionList* list = data;
+    return run_dial(list, arena).landed;
 }
 
-DayResult day01(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
+static int64_t part_two(void* data, Arena* arena) {
+    InstructionList* list = data;
+    return run_dial(list, arena).passed;
+}
+
+DayResult day01_stream(int fd) {
+    DayResult result = {0};
+    Stopwatch sw;
+    stopwatch_start(&sw);
+
+    // The chunk buffer lives in the stream; keep it off the stack
+    LineStream* stream = malloc(sizeof(LineStream));
+    line_stream_init(stream, fd);
+
+    Dial dial = dial_start();
+    Span line;
+    Instruction ins;
+    while (line_stream_next(stream, &line)) {
+        if (parse_instruction(line, &ins)) {
+            dial_turn(&dial, ins.sign, ins.steps);
+        }
+    }
+    free(stream);
+
+    // Both parts come out of the same pass, so it is all "parse" time
+    result.part1 = dial.landed;
+    result.part2 = dial.passed;
+    stopwatch_lap(&sw, &result.timings.parse_ms);
+    return result;
 }
+
+const DaySolver day01 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
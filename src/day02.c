@@ -9,207 +9,215 @@ typedef struct {
     uint64_t end;
 } Range;
 
+typedef struct {
+    Range* ranges;
+    int count;
+} RangeList;
+
 static int count_digits(uint64_t n) {
-    if (n == 0) return 1;
-    int count = 0;
-    while (n > 0) {
+    int count = 1;
+    while (n >= 10) {
         count++;
         n /= 10;
     }
     return count;
 }
 
-static uint64_t power10(int exp) {
-    uint64_t result = 1;
+static u128 power10(int exp) {
+    u128 result = 1;
     for (int i = 0; i < exp; i++) {
         result *= 10;
     }
     return result;
 }
 
-static Range* parse_input(const char* input, int* count) {
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    const char* end = input + len;
+
     // Count commas to determine number of ranges
     int num_ranges = 1;
-    for (const char* p = input; *p; p++) {
-        if (*p == ',') num_ranges++;
+    for (const char* p = scan_byte(input, end, ','); p < end; p = scan_byte(p + 1, end, ',')) {
+        num_ranges++;
     }
 
-    Range* ranges = malloc(num_ranges * sizeof(Range));
-    *count = 0;
+    RangeList* list = malloc(sizeof(RangeList));
+    list->ranges = malloc(num_ranges * sizeof(Range));
+    list->count = 0;
 
+    // "start-end" pairs separated by commas
     const char* p = input;
-    while (*p) {
-        // Skip whitespace and commas
-        while (*p && (*p == ' ' || *p == ',' || *p == '\n')) p++;
-        if (!*p) break;
-
-        // Parse start
-        uint64_t start = 0;
-        while (*p >= '0' && *p <= '9') {
-            start = start * 10 + (*p - '0');
-            p++;
-        }
-
-        // Skip dash
-        while (*p && *p == '-') p++;
-
-        // Parse end
-        uint64_t end = 0;
-        while (*p >= '0' && *p <= '9') {
-            end = end * 10 + (*p - '0');
-            p++;
-        }
-
-        ranges[*count].start = start;
-        ranges[*count].end = end;
-        (*count)++;
+    uint64_t start, stop;
+    while (list->count < num_ranges && scan_uint(&p, end, &start) && scan_uint(&p, end, &stop)) {
+        list->ranges[list->count].start = start;
+        list->ranges[list->count].end = stop;
+        list->count++;
     }
 
-    return ranges;
+    return list;
 }
 
-// Generate all doubled numbers within a range and sum them
-static uint64_t sum_doubled_in_range(uint64_t start, uint64_t end) {
-    uint64_t sum = 0;
+static void free_input(void* data) {
+    RangeList* list = data;
+    free(list->ranges);
+    free(list);
+}
 
-    int start_digits = count_digits(start);
-    int end_digits = count_digits(end);
+// Sum of the total_digits-digit numbers in [start, end] made of a
+// pattern_len-digit pattern repeated. Each is pattern * R with the repunit
+// R = (10^total - 1) / (10^pattern_len - 1) (e.g. 1001001 for 3 x 3 digits),
+// so this is R times an arithmetic series over the clamped pattern interval.
+static u128 sum_periodic(uint64_t start, uint64_t end, int total_digits, int pattern_len) {
+    u128 repunit = (power10(total_digits) - 1) / (power10(pattern_len) - 1);
+
+    u128 lo = ((u128)start + repunit - 1) / repunit;
+    u128 hi = (u128)end / repunit;
+    u128 min_pattern = power10(pattern_len - 1);
+    u128 max_pattern = power10(pattern_len) - 1;
+    if (lo < min_pattern) lo = min_pattern;
+    if (hi > max_pattern) hi = max_pattern;
+    if (lo > hi) return 0;
+
+    return repunit * ((lo + hi) * (hi - lo + 1) / 2);
+}
 
-    for (int total_digits = start_digits; total_digits <= end_digits; total_digits++) {
-        if (total_digits % 2 != 0) continue;
+// Sum of the total_digits-digit doubled numbers (pattern repeated exactly
+// twice) within [start, end]
+static u128 sum_doubled_class(uint64_t start, uint64_t end, int total_digits) {
+    if (total_digits % 2 != 0) return 0;
+    return sum_periodic(start, end, total_digits, total_digits / 2);
+}
 
-        int half_digits = total_digits / 2;
-        uint64_t min_half = power10(half_digits - 1);
-        uint64_t max_half = power10(half_digits) - 1;
-        uint64_t multiplier = power10(half_digits);
+// Sum of the total_digits-digit numbers within [start, end] made of any
+// pattern repeated at least twice, each counted once. A number of length L
+// repeats with a proper period exactly when it repeats with period L/p for
+// some prime p | L, and repeating with both L/p and L/q means repeating with
+// L/(pq), so inclusion-exclusion over the prime factors of L (the Mobius
+// function over its divisors) removes duplicates.
+static u128 sum_repeated_class(uint64_t start, uint64_t end, int total_digits) {
+    int primes[8];
+    int num_primes = 0;
+    for (int n = total_digits, p = 2; n > 1; p++) {
+        if (n % p != 0) continue;
+        primes[num_primes++] = p;
+        while (n % p == 0) n /= p;
+    }
 
-        for (uint64_t half = min_half; half <= max_half; half++) {
-            uint64_t doubled = half * multiplier + half;
-            if (doubled >= start && doubled <= end) {
-                sum += doubled;
-            }
+    // Odd-sized subsets add, even-sized ones subtract (mod 2^128, the
+    // total is non-negative)
+    u128 sum = 0;
+    for (int mask = 1; mask < (1 << num_primes); mask++) {
+        int divisor = 1;
+        for (int i = 0; i < num_primes; i++) {
+            if (mask >> i & 1) divisor *= primes[i];
+        }
+        u128 part = sum_periodic(start, end, total_digits, total_digits / divisor);
+        if (__builtin_popcount(mask) % 2) {
+            sum += part;
+        } else {
+            sum -= part;
         }
     }
-
     return sum;
 }
 
-static int64_t part_one(const char* input) {
-    int count;
-    Range* ranges = parse_input(input, &count);
-
-    uint64_t sum = 0;
-    for (int i = 0; i < count; i++) {
-        sum += sum_doubled_in_range(ranges[i].start, ranges[i].end);
-    }
-
-    free(ranges);
-    return (int64_t)sum;
-}
-
-// For part 2, we need to track seen numbers to avoid duplicates
-#define HASH_SIZE 10007
+#define MAX_DIGITS 20
+#define PARALLEL_MIN_RANGES (1 << 12)
 
-typedef struct HashNode {
-    uint64_t value;
-    struct HashNode* next;
-} HashNode;
+typedef u128 (*ClassSum)(uint64_t start, uint64_t end, int total_digits);
 
+// Prefix sums over whole digit-length classes: below[L] is the sum of all
+// matching numbers with fewer than L digits. Each class is evaluated once,
+// so a range costs one partial class at each endpoint however many digit
+// lengths it spans.
 typedef struct {
-    HashNode* buckets[HASH_SIZE];
-} HashSet;
+    ClassSum class_sum;
+    u128 below[MAX_DIGITS + 1];
+} PrefixTable;
+
+static void prefix_table_init(PrefixTable* table, ClassSum class_sum) {
+    table->class_sum = class_sum;
+    table->below[1] = 0;
+    for (int digits = 1; digits < MAX_DIGITS; digits++) {
+        uint64_t first = (uint64_t)power10(digits - 1);
+        uint64_t last = (uint64_t)power10(digits) - 1;
+        table->below[digits + 1] = table->below[digits] + class_sum(first, last, digits);
+    }
+}
 
-static void hashset_init(HashSet* set) {
-    memset(set->buckets, 0, sizeof(set->buckets));
+// Sum of matching numbers in [1, n]
+static u128 prefix_sum(const PrefixTable* table, uint64_t n) {
+    if (n == 0) return 0;
+    int digits = count_digits(n);
+    return table->below[digits] + table->class_sum((uint64_t)power10(digits - 1), n, digits);
 }
 
-static void hashset_free(HashSet* set) {
-    for (int i = 0; i < HASH_SIZE; i++) {
-        HashNode* node = set->buckets[i];
-        while (node) {
-            HashNode* next = node->next;
-            free(node);
-            node = next;
-        }
-    }
+// Ranges may overlap; each one counts its numbers on its own, so the total
+// is a sum of prefix differences and no merging is needed
+static u128 range_sum(const PrefixTable* table, Range range) {
+    if (range.start > range.end) return 0;
+    u128 below_start = range.start > 0 ? prefix_sum(table, range.start - 1) : 0;
+    return prefix_sum(table, range.end) - below_start;
 }
 
-static bool hashset_contains(HashSet* set, uint64_t value) {
-    int idx = value % HASH_SIZE;
-    HashNode* node = set->buckets[idx];
-    while (node) {
-        if (node->value == value) return true;
-        node = node->next;
+typedef struct {
+    const RangeList* list;
+    const PrefixTable* table;
+    int chunk_size;
+    u128* sums;             // one partial sum per chunk
+} SumJob;
+
+static void sum_chunk(void* ctx, int c) {
+    SumJob* job = ctx;
+    int begin = c * job->chunk_size;
+    int end = begin + job->chunk_size;
+    if (end > job->list->count) end = job->list->count;
+
+    u128 sum = 0;
+    for (int i = begin; i < end; i++) {
+        sum += range_sum(job->table, job->list->ranges[i]);
     }
-    return false;
+    job->sums[c] = sum;
 }
 
-static void hashset_insert(HashSet* set, uint64_t value) {
-    if (hashset_contains(set, value)) return;
-    int idx = value % HASH_SIZE;
-    HashNode* node = malloc(sizeof(HashNode));
-    node->value = value;
-    node->next = set->buckets[idx];
-    set->buckets[idx] = node;
-}
+static int64_t sum_ranges(const RangeList* list, ClassSum class_sum, Arena* arena) {
+    PrefixTable table;
+    prefix_table_init(&table, class_sum);
 
-// Generate all repeated-pattern numbers within a range and sum them
-static uint64_t sum_repeated_in_range(uint64_t start, uint64_t end) {
-    uint64_t sum = 0;
-    HashSet seen;
-    hashset_init(&seen);
-
-    int start_digits = count_digits(start);
-    int end_digits = count_digits(end);
-
-    for (int total_digits = start_digits; total_digits <= end_digits; total_digits++) {
-        // Try each possible pattern length (1 to total_digits/2)
-        for (int pattern_len = 1; pattern_len <= total_digits / 2; pattern_len++) {
-            if (total_digits % pattern_len != 0) continue;
-
-            int repeat_count = total_digits / pattern_len;
-            if (repeat_count < 2) continue;
-
-            // Generate all patterns of this length
-            uint64_t min_pattern = (pattern_len == 1) ? 1 : power10(pattern_len - 1);
-            uint64_t max_pattern = power10(pattern_len) - 1;
-            uint64_t multiplier = power10(pattern_len);
-
-            for (uint64_t pattern = min_pattern; pattern <= max_pattern; pattern++) {
-                // Build the repeated number
-                uint64_t num = 0;
-                for (int i = 0; i < repeat_count; i++) {
-                    num = num * multiplier + pattern;
-                }
-
-                if (num >= start && num <= end && !hashset_contains(&seen, num)) {
-                    hashset_insert(&seen, num);
-                    sum += num;
-                }
-            }
+    u128 sum = 0;
+    if (!fast_path(list->count, PARALLEL_MIN_RANGES)) {
+        for (int i = 0; i < list->count; i++) {
+            sum += range_sum(&table, list->ranges[i]);
         }
+        return (int64_t)sum;
     }
 
-    hashset_free(&seen);
-    return sum;
-}
-
-static int64_t part_two(const char* input) {
-    int count;
-    Range* ranges = parse_input(input, &count);
+    int chunks = parallel_threads() * 4;
+    SumJob job = {
+        .list = list,
+        .table = &table,
+        .chunk_size = (list->count + chunks - 1) / chunks,
+        .sums = arena_alloc(arena, chunks * sizeof(u128)),
+    };
+    parallel_for(chunks, sum_chunk, &job);
 
-    uint64_t sum = 0;
-    for (int i = 0; i < count; i++) {
-        sum += sum_repeated_in_range(ranges[i].start, ranges[i].end);
+    for (int c = 0; c < chunks; c++) {
+        sum += job.sums[c];
     }
-
-    free(ranges);
     return (int64_t)sum;
 }
 
-DayResult day02(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
+static int64_t part_one(void* data, Arena* arena) {
+    return sum_ranges(data, sum_doubled_class, arena);
+}
+
+static int64_t part_two(void* data, Arena* arena) {
+    return sum_ranges(data, sum_repeated_class, arena);
 }
+
+const DaySolver day02 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
@@ -1,83 +1,222 @@
 // Day 3: Lobby - Extract maximum value by selecting digits in order
-// Greedy algorithm: pick largest digit that leaves enough remaining
+// The largest k-digit subsequence of a bank is built with a monotonic stack:
+// a digit pops smaller digits before it while enough digits remain to refill
 
 #include "common.h"
+#include "days.h"
 
-static int max_two_digit(const char* bank) {
-    int len = strlen(bank);
-    int max_val = 0;
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define PART1_DIGITS 2
+#define PART2_DIGITS 12
+
+// Banks up to this long use the SIMD window scan instead of the stack
+#define SHORT_BANK_LEN 128
+
+// Banks per parallel batch; a bank takes well under a microsecond
+#define PARALLEL_GRAIN 1024
+
+typedef struct {
+    Span* lines;
+    int count;
+    bool have_part2;
+    int64_t part2;          // computed in the same pass as part 1
+} Banks;
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    Banks* banks = calloc(1, sizeof(Banks));
+    banks->lines = collect_lines(input, len, &banks->count);
+    return banks;
+}
+
+static void free_input(void* data) {
+    Banks* banks = data;
+    free(banks->lines);
+    free(banks);
+}
+
+// Largest k-digit subsequence being built over a bank
+typedef struct {
+    char digits[DAY03_MAX_DIGITS];
+    int size;
+    int k;
+} DigitStack;
+
+static u128 stack_value(const DigitStack* stack) {
+    if (stack->size < stack->k) return 0;       // bank shorter than k
+
+    u128 value = 0;
+    for (int i = 0; i < stack->size; i++) {
+        value = value * 10 + (unsigned)(stack->digits[i] - '0');
+    }
+    return value;
+}
+
+// One pass over the bank feeding every stack, so all k come out together.
+// A digit may replace a smaller top while the digits from it to the end
+// can still fill the stack, which keeps each stack non-increasing where it
+// matters and makes the pass O(len) per stack.
+static void select_digits(const char* bank, int len, DigitStack* stacks, int num_stacks) {
+    for (int s = 0; s < num_stacks; s++) {
+        stacks[s].size = 0;
+    }
 
     for (int i = 0; i < len; i++) {
-        for (int j = i + 1; j < len; j++) {
-            int val = (bank[i] - '0') * 10 + (bank[j] - '0');
-            if (val > max_val) max_val = val;
+        char c = bank[i];
+        int left = len - i;             // digits from i to the end
+        for (int s = 0; s < num_stacks; s++) {
+            DigitStack* stack = &stacks[s];
+            while (stack->size > 0 && stack->digits[stack->size - 1] < c &&
+                   stack->size - 1 + left >= stack->k) {
+                stack->size--;
+            }
+            if (stack->size < stack->k) {
+                stack->digits[stack->size++] = c;
+            }
         }
     }
-
-    return max_val;
 }
 
-static int64_t part_one(const char* input) {
-    int count;
-    char** lines = split_lines(input, &count);
+// Index of the first largest digit in bank[start, end)
+static int first_max_index(const char* bank, int start, int end) {
+    int best = start;
+    int i = start + 1;
+
+#ifdef __SSE2__
+    if (end - start >= 16) {
+        // A '9' can't be beaten, and in most banks one turns up early
+        __m128i nines = _mm_set1_epi8('9');
+        for (i = start; i + 16 <= end; i += 16) {
+            __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(bank + i)), nines);
+            int mask = _mm_movemask_epi8(eq);
+            if (mask) return i + __builtin_ctz(mask);
+        }
+
+        // Max reduction over whole vectors, then the scalar tail
+        __m128i max = _mm_loadu_si128((const __m128i*)(bank + start));
+        for (i = start + 16; i + 16 <= end; i += 16) {
+            max = _mm_max_epu8(max, _mm_loadu_si128((const __m128i*)(bank + i)));
+        }
+        max = _mm_max_epu8(max, _mm_srli_si128(max, 8));
+        max = _mm_max_epu8(max, _mm_srli_si128(max, 4));
+        max = _mm_max_epu8(max, _mm_srli_si128(max, 2));
+        max = _mm_max_epu8(max, _mm_srli_si128(max, 1));
+        char top = (char)_mm_cvtsi128_si32(max);
+        for (; i < end; i++) {
+            if (bank[i] > top) top = bank[i];
+        }
 
-    int64_t sum = 0;
-    for (int i = 0; i < count; i++) {
-        if (lines[i][0]) {
-            sum += max_two_digit(lines[i]);
+        // First position holding it
+        __m128i target = _mm_set1_epi8(top);
+        for (i = start; i + 16 <= end; i += 16) {
+            __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(bank + i)), target);
+            int mask = _mm_movemask_epi8(eq);
+            if (mask) return i + __builtin_ctz(mask);
         }
+        while (bank[i] != top) i++;
+        return i;
     }
+#endif
 
-    free_lines(lines, count);
-    return sum;
+    for (; i < end; i++) {
+        if (bank[i] > bank[best]) best = i;
+    }
+    return best;
 }
 
-// Greedy: for each position, pick the largest available digit
-// that still leaves enough digits remaining for the rest
-static int64_t max_n_digits(const char* bank, int n) {
-    int len = strlen(bank);
-    if (n > len) return 0;
+// Greedy with a vectorized window scan: each pick takes the first largest
+// digit that still leaves enough digits for the rest. O(len * k) but with
+// short banks the windows are a few vectors each.
+static u128 max_digits_short(const char* bank, int len, int k) {
+    if (k > len) return 0;
 
-    int64_t result = 0;
+    u128 result = 0;
     int start = 0;
+    for (int i = 0; i < k; i++) {
+        int end = len - (k - i - 1);
+        int best = first_max_index(bank, start, end);
+        result = result * 10 + (unsigned)(bank[best] - '0');
+        start = best + 1;
+    }
+    return result;
+}
 
-    for (int i = 0; i < n; i++) {
-        int remaining_picks = n - i - 1;
-        int end = len - remaining_picks;
+// Add one bank's largest number for each stack's k to sums. A short bank
+// stays in L1 while every k is picked from it; a long one gets one stack
+// pass for all of them.
+static void add_bank(const char* bank, int len, DigitStack* stacks, int num_stacks, u128* sums) {
+    if (!len) return;
 
-        // Find the largest digit in range [start, end)
-        int best_idx = start;
-        for (int j = start; j < end; j++) {
-            if (bank[j] > bank[best_idx]) {
-                best_idx = j;
-            }
+    if (len <= SHORT_BANK_LEN) {
+        for (int s = 0; s < num_stacks; s++) {
+            sums[s] += max_digits_short(bank, len, stacks[s].k);
         }
-
-        result = result * 10 + (bank[best_idx] - '0');
-        start = best_idx + 1;
+        return;
     }
 
-    return result;
+    select_digits(bank, len, stacks, num_stacks);
+    for (int s = 0; s < num_stacks; s++) {
+        sums[s] += stack_value(&stacks[s]);
+    }
 }
 
-static int64_t part_two(const char* input) {
-    int count;
-    char** lines = split_lines(input, &count);
+bool day03_max_digit_sums(const char* input, size_t len, const int* ks, int num_ks, u128* sums) {
+    for (int j = 0; j < num_ks; j++) {
+        if (ks[j] < 1 || ks[j] > DAY03_MAX_DIGITS) return false;
+    }
 
-    int64_t sum = 0;
-    for (int i = 0; i < count; i++) {
-        if (lines[i][0]) {
-            sum += max_n_digits(lines[i], 12);
-        }
+    DigitStack* stacks = malloc((num_ks > 0 ? num_ks : 1) * sizeof(DigitStack));
+    for (int j = 0; j < num_ks; j++) {
+        stacks[j].k = ks[j];
+        sums[j] = 0;
+    }
+
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line)) {
+        add_bank(line.ptr, line.len, stacks, num_ks, sums);
     }
 
-    free_lines(lines, count);
-    return sum;
+    free(stacks);
+    return true;
 }
 
-DayResult day03(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
+// Both parts for one bank (each value is at most 12 digits)
+static void sum_bank(void* ctx, int i, Arena* scratch, int64_t* sums) {
+    (void)scratch;
+    const Banks* banks = ctx;
+
+    DigitStack stacks[2] = {{.k = PART1_DIGITS}, {.k = PART2_DIGITS}};
+    u128 values[2] = {0, 0};
+    add_bank(banks->lines[i].ptr, banks->lines[i].len, stacks, 2, values);
+    sums[0] += (int64_t)values[0];
+    sums[1] += (int64_t)values[1];
 }
+
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
+    Banks* banks = data;
+
+    int64_t sums[2];
+    parallel_sum(banks->count, PARALLEL_GRAIN, 2, sum_bank, banks, sums);
+
+    banks->part2 = sums[1];
+    banks->have_part2 = true;
+    return sums[0];
+}
+
+static int64_t part_two(void* data, Arena* arena) {
+    Banks* banks = data;
+    if (!banks->have_part2) part_one(data, arena);
+    return banks->part2;
+}
+
+const DaySolver day03 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
@@ -1,111 +1,518 @@
 // Day 4: Printing Department - Grid with '@' rolls
 // A roll is accessible if it has fewer than 4 adjacent rolls (8 directions)
+//
+// The grid is bit-packed, one bit per cell, and neighbor counts for a whole
+// 64-cell word come from a carry-save adder over the 8 shifted neighbor masks.
 
 #include "common.h"
+#include "days.h"
 
+#include <pthread.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Rows per band: the unit of parallel packing and counting, and of the
+// threaded stencil
+#define BAND_ROWS 32
+
+// Grids with at least this many cells are packed and counted by bands in
+// parallel; part two switches from the worklist (about 7 bytes per cell)
+// to the banded stencil, which works on the bits in place
+#define PARALLEL_MIN_CELLS (1 << 22)
+#define STENCIL_MIN_CELLS (1LL << 26)
+
+// One bit per cell, row-major. Each row is padded with an empty word on both
+// sides and the grid with an empty row above and below, so every cell has 8
+// neighbors to read and no bounds checks are needed.
 typedef struct {
-    char** grid;
+    uint64_t* words;
     int rows;
     int cols;
-} Grid;
+    int stride;         // words per padded row
+} BitGrid;
+
+// First word of row r (r may be -1 or rows for the padding rows)
+static inline uint64_t* grid_row(const BitGrid* g, int r) {
+    return g->words + (size_t)(r + 1) * g->stride + 1;
+}
+
+static inline int grid_width(const BitGrid* g) {
+    return (g->cols + 63) / 64;
+}
+
+// Set the bits of the '@' cells in one input row
+static void pack_row(uint64_t* row, const char* line, int len) {
+    int c = 0;
+#ifdef __SSE2__
+    __m128i roll = _mm_set1_epi8('@');
+    for (; c + 16 <= len; c += 16) {
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(line + c)), roll);
+        row[c / 64] |= (uint64_t)(unsigned)_mm_movemask_epi8(eq) << (c % 64);
+    }
+#endif
+    for (; c < len; c++) {
+        if (line[c] == '@') row[c / 64] |= 1ULL << (c % 64);
+    }
+}
+
+static int grid_bands(const BitGrid* g) {
+    return (g->rows + BAND_ROWS - 1) / BAND_ROWS;
+}
 
-static Grid parse_input(const char* input) {
+static bool grid_is_large(const BitGrid* g) {
+    return fast_path((int64_t)g->rows * g->cols, PARALLEL_MIN_CELLS);
+}
+
+typedef struct {
+    BitGrid* g;
+    const Span* lines;
+} PackJob;
+
+static void pack_band(void* ctx, int b) {
+    PackJob* job = ctx;
+    BitGrid* g = job->g;
+    int end = (b + 1) * BAND_ROWS < g->rows ? (b + 1) * BAND_ROWS : g->rows;
+    for (int r = b * BAND_ROWS; r < end; r++) {
+        int n = job->lines[r].len < g->cols ? job->lines[r].len : g->cols;
+        pack_row(grid_row(g, r), job->lines[r].ptr, n);
+    }
+}
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
     int count;
-    char** lines = split_lines(input, &count);
+    Span* lines = collect_lines(input, len, &count);
 
-    Grid g;
-    g.rows = count;
-    g.cols = (count > 0) ? strlen(lines[0]) : 0;
-    g.grid = lines;
+    BitGrid* g = malloc(sizeof(BitGrid));
+    g->rows = count;
+    g->cols = (count > 0) ? lines[0].len : 0;
+    g->stride = grid_width(g) + 2;
+    g->words = calloc((size_t)(g->rows + 2) * g->stride, sizeof(uint64_t));
 
+    // Bands write disjoint words, so big grids pack in parallel
+    PackJob job = { .g = g, .lines = lines };
+    if (grid_is_large(g)) {
+        parallel_for(grid_bands(g), pack_band, &job);
+    } else {
+        for (int b = 0; b < grid_bands(g); b++) pack_band(&job, b);
+    }
+
+    free(lines);
     return g;
 }
 
-static void free_grid(Grid* g) {
-    free_lines(g->grid, g->rows);
+static void free_grid(void* data) {
+    BitGrid* g = data;
+    free(g->words);
+    free(g);
 }
 
-static int count_adjacent_rolls(Grid* g, int row, int col) {
-    int count = 0;
+// Cells whose left / right neighbor is set: bit c of the result is bit c-1
+// (resp. c+1) of the row, pulling in the edge bit of the adjacent word
+static inline uint64_t from_left(const uint64_t* row, int w) {
+    return row[w] << 1 | row[w - 1] >> 63;
+}
 
-    for (int dr = -1; dr <= 1; dr++) {
-        for (int dc = -1; dc <= 1; dc++) {
-            if (dr == 0 && dc == 0) continue;
+static inline uint64_t from_right(const uint64_t* row, int w) {
+    return row[w] >> 1 | row[w + 1] << 63;
+}
 
-            int nr = row + dr;
-            int nc = col + dc;
+// Rolls in word w of row mid with fewer than 4 neighboring rolls, given the
+// padded rows above and below. The 8 neighbor masks are summed bit-sliced:
+// full adders reduce them to a ones bit and four twos carries, and those to
+// the fours bits, which are set exactly where the count is 4 or more.
+static inline uint64_t accessible_bits(const uint64_t* up, const uint64_t* mid,
+                                       const uint64_t* down, int w) {
+    uint64_t u = up[w], ul = from_left(up, w), ur = from_right(up, w);
+    uint64_t d = down[w], dl = from_left(down, w), dr = from_right(down, w);
+    uint64_t l = from_left(mid, w), rt = from_right(mid, w);
 
-            if (nr >= 0 && nr < g->rows && nc >= 0 && nc < g->cols) {
-                if (g->grid[nr][nc] == '@') {
-                    count++;
-                }
-            }
+    // Weight 1
+    uint64_t sum_up = u ^ ul ^ ur, carry_up = (u & ul) | (ur & (u ^ ul));
+    uint64_t sum_down = d ^ dl ^ dr, carry_down = (d & dl) | (dr & (d ^ dl));
+    uint64_t sum_mid = l ^ rt, carry_mid = l & rt;
+    uint64_t carry_ones = (sum_up & sum_down) | (sum_mid & (sum_up ^ sum_down));
+
+    // Weight 2: four carries; their own carries have weight 4
+    uint64_t twos = carry_up ^ carry_down ^ carry_mid;
+    uint64_t fours_a = (carry_up & carry_down) | (carry_mid & (carry_up ^ carry_down));
+    uint64_t fours_b = twos & carry_ones;
+
+    return mid[w] & ~(fours_a | fours_b);
+}
+
+static inline uint64_t accessible_word(const BitGrid* g, int r, int w) {
+    return accessible_bits(grid_row(g, r - 1), grid_row(g, r), grid_row(g, r + 1), w);
+}
+
+static void count_band(void* ctx, int b, Arena* scratch, int64_t* sums) {
+    (void)scratch;
+    const BitGrid* g = ctx;
+    int width = grid_width(g);
+    int end = (b + 1) * BAND_ROWS < g->rows ? (b + 1) * BAND_ROWS : g->rows;
+
+    for (int r = b * BAND_ROWS; r < end; r++) {
+        for (int w = 0; w < width; w++) {
+            sums[0] += __builtin_popcountll(accessible_word(g, r, w));
         }
     }
+}
+
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
+    BitGrid* g = data;
 
-    return count;
+    // Small grids fit in one grain and are counted on this thread
+    int64_t accessible;
+    int grain = grid_is_large(g) ? 1 : grid_bands(g);
+    parallel_sum(grid_bands(g), grain, 1, count_band, g, &accessible);
+    return accessible;
 }
 
-static int64_t part_one(const char* input) {
-    Grid g = parse_input(input);
-    int accessible = 0;
+// Marker for cells without a roll: high enough that the at most 8
+// decrements from removed neighbors never bring it down to 3
+#define NO_ROLL 0x80
+
+// Removal cascade driven by a worklist. Neighbor counts are computed once;
+// removing a roll decrements its neighbors, and a roll whose count drops
+// from 4 to 3 joins the queue. The queue is processed level by level: level
+// 1 holds the rolls accessible at the start, level k+1 those freed by level
+// k, which are exactly the synchronous rounds, so the total and the
+// per-round counts match a full rescan per round in O(cells). Clears the
+// removed rolls from the grid and, if rounds is not NULL, stores a malloc'd
+// array of per-round removal counts there. Returns the number of rounds.
+static int run_cascade(BitGrid* g, Arena* arena, int64_t* total, int64_t** rounds) {
+    // Byte cell i is bit i of the padded bit grid, so a queued cell clears
+    // its roll without any index arithmetic
+    size_t size = (size_t)(g->rows + 2) * g->stride * 64;
+    int pitch = g->stride * 64;
+    ArenaMark mark = arena_mark(arena);
+
+    // Unpack to one byte per cell, spreading 8 bits to the low bit of 8
+    // bytes at a time, and count neighbors with a horizontal then a
+    // vertical 3-cell sum (plain byte loops that vectorize)
+    uint8_t* restrict cells = arena_alloc(arena, size);
+    int num_rolls = 0;
+    for (size_t w = 0; w < size / 64; w++) {
+        uint64_t word = g->words[w];
+        num_rolls += __builtin_popcountll(word);
+        for (int b = 0; b < 8; b++) {
+            uint64_t spread = ((word >> (8 * b)) & 0xFF) * 0x0101010101010101ULL;
+            spread &= 0x8040201008040201ULL;
+            spread = ((spread + 0x00406070787C7E7FULL) >> 7) & 0x0101010101010101ULL;
+            memcpy(cells + w * 64 + b * 8, &spread, 8);
+        }
+    }
 
-    for (int row = 0; row < g.rows; row++) {
-        for (int col = 0; col < g.cols; col++) {
-            if (g.grid[row][col] == '@' && count_adjacent_rolls(&g, row, col) < 4) {
-                accessible++;
+    uint8_t* restrict across = arena_calloc(arena, size, 1);
+    for (size_t i = 1; i + 1 < size; i++) {
+        across[i] = cells[i - 1] + cells[i] + cells[i + 1];
+    }
+
+    // Rolls get their neighbor count, empty cells NO_ROLL plus a little
+    uint8_t* restrict count = arena_alloc(arena, size);
+    memset(count, NO_ROLL, pitch);
+    memset(count + size - pitch, NO_ROLL, pitch);
+    for (size_t i = pitch; i + pitch < size; i++) {
+        uint8_t n = across[i - pitch] + across[i] + across[i + pitch] - cells[i];
+        count[i] = n | (uint8_t)((cells[i] ^ 1) << 7);
+    }
+
+    // Every roll is queued at most once; the first level is what part one
+    // counts, taken straight from the bit kernel
+    int width = grid_width(g);
+    int* queue = arena_alloc(arena, (num_rolls + 1) * sizeof(int));
+    int tail = 0;
+    for (int r = 0; r < g->rows; r++) {
+        int base = (int)(grid_row(g, r) - g->words) * 64;
+        for (int w = 0; w < width; w++) {
+            for (uint64_t bits = accessible_word(g, r, w); bits; bits &= bits - 1) {
+                queue[tail++] = base + w * 64 + __builtin_ctzll(bits);
             }
         }
     }
 
-    free_grid(&g);
-    return accessible;
+    const int offsets[8] = {-pitch - 1, -pitch, -pitch + 1, -1, 1, pitch - 1, pitch, pitch + 1};
+    int capacity = 16;
+    int64_t* per_round = rounds ? malloc(capacity * sizeof(int64_t)) : NULL;
+    int num_rounds = 0;
+    int head = 0;
+
+    while (head < tail) {
+        int level_end = tail;
+        if (per_round) {
+            if (num_rounds >= capacity) {
+                capacity *= 2;
+                per_round = realloc(per_round, capacity * sizeof(int64_t));
+            }
+            per_round[num_rounds] = level_end - head;
+        }
+        num_rounds++;
+
+        for (; head < level_end; head++) {
+            int cell = queue[head];
+            g->words[cell >> 6] &= ~(1ULL << (cell & 63));
+            // Branchless push: the slot is overwritten unless the
+            // neighbor just dropped to 3 (queue has room, see above)
+            for (int k = 0; k < 8; k++) {
+                int next = cell + offsets[k];
+                queue[tail] = next;
+                tail += --count[next] == 3;
+            }
+        }
+    }
+
+    *total = tail;
+    if (rounds) *rounds = per_round;
+    arena_release(arena, mark);
+    return num_rounds;
 }
 
-static int64_t part_two(const char* input) {
-    Grid g = parse_input(input);
-    int total_removed = 0;
-
-    // Dynamic array for positions to remove
-    int capacity = 64;
-    int* to_remove = malloc(capacity * 2 * sizeof(int));
-    int remove_count;
-
-    while (1) {
-        remove_count = 0;
-
-        for (int row = 0; row < g.rows; row++) {
-            for (int col = 0; col < g.cols; col++) {
-                if (g.grid[row][col] == '@' && count_adjacent_rolls(&g, row, col) < 4) {
-                    if (remove_count * 2 >= capacity) {
-                        capacity *= 2;
-                        to_remove = realloc(to_remove, capacity * 2 * sizeof(int));
-                    }
-                    to_remove[remove_count * 2] = row;
-                    to_remove[remove_count * 2 + 1] = col;
-                    remove_count++;
+// Barrier that participants can leave, so a worker thread that could not
+// be started doesn't hold up the others
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int count;
+    int waiting;
+    unsigned generation;
+} Barrier;
+
+static void barrier_init(Barrier* b, int count) {
+    pthread_mutex_init(&b->lock, NULL);
+    pthread_cond_init(&b->cond, NULL);
+    b->count = count;
+    b->waiting = 0;
+    b->generation = 0;
+}
+
+static void barrier_destroy(Barrier* b) {
+    pthread_cond_destroy(&b->cond);
+    pthread_mutex_destroy(&b->lock);
+}
+
+static void barrier_open(Barrier* b) {
+    b->waiting = 0;
+    b->generation++;
+    pthread_cond_broadcast(&b->cond);
+}
+
+static void barrier_wait(Barrier* b) {
+    pthread_mutex_lock(&b->lock);
+    unsigned generation = b->generation;
+    if (++b->waiting == b->count) {
+        barrier_open(b);
+    } else {
+        while (generation == b->generation) {
+            pthread_cond_wait(&b->cond, &b->lock);
+        }
+    }
+    pthread_mutex_unlock(&b->lock);
+}
+
+static void barrier_leave(Barrier* b) {
+    pthread_mutex_lock(&b->lock);
+    b->count--;
+    if (b->waiting > 0 && b->waiting == b->count) barrier_open(b);
+    pthread_mutex_unlock(&b->lock);
+}
+
+// Synchronous removal rounds as a banded stencil. Bands of BAND_ROWS rows
+// are dealt round-robin to worker threads and updated in place; a band only
+// reads its neighbors through halos, copies of their first and last rows
+// taken at the start of each round, so every round sees the grid as it was
+// before the round. A band is skipped when neither it nor a neighbor
+// changed in the previous round, since nothing can have become accessible.
+typedef struct {
+    BitGrid* g;
+    int width;
+    int num_bands;
+    int workers;            // fixed once all threads are started
+    uint64_t* halos;        // per band: its first and last row (padded)
+    uint64_t* line_buffers; // per worker: two padded rows
+    int64_t* removed[2];    // per band, by round parity
+    int64_t* rounds;        // per-round totals, recorded by worker 0
+    int num_rounds;
+    int capacity;
+    int64_t total;
+    Barrier barrier;
+} Stencil;
+
+typedef struct {
+    Stencil* stencil;
+    int index;
+} StencilWorker;
+
+static uint64_t* halo_row(const Stencil* s, int band, int last) {
+    return s->halos + ((size_t)band * 2 + last) * s->g->stride + 1;
+}
+
+// One round on one band; returns the number of rolls removed. Each row is
+// copied to a line buffer before it is updated, and the copy serves both
+// as the row's own neighbors and as the row above for the next one.
+static int64_t stencil_band(Stencil* s, int b, uint64_t* buffers[2]) {
+    BitGrid* g = s->g;
+    int first = b * BAND_ROWS;
+    int end = first + BAND_ROWS < g->rows ? first + BAND_ROWS : g->rows;
+    const uint64_t* up = b > 0 ? halo_row(s, b - 1, 1) : grid_row(g, -1);
+    int64_t removed = 0;
+
+    for (int r = first; r < end; r++) {
+        uint64_t* row = grid_row(g, r);
+        uint64_t* mid = buffers[r & 1];
+        const uint64_t* down = r + 1 < end ? grid_row(g, r + 1)
+                             : b + 1 < s->num_bands ? halo_row(s, b + 1, 0)
+                             : grid_row(g, g->rows);
+        memcpy(mid, row, s->width * sizeof(uint64_t));
+
+        for (int w = 0; w < s->width; w++) {
+            uint64_t bits = accessible_bits(up, mid, down, w);
+            row[w] = mid[w] & ~bits;
+            removed += __builtin_popcountll(bits);
+        }
+        up = mid;
+    }
+
+    return removed;
+}
+
+static void stencil_run(Stencil* s, int t) {
+    barrier_wait(&s->barrier);          // wait for the worker count
+    int workers = s->workers;
+    int n = s->num_bands;
+    size_t row_words = s->g->stride;
+    uint64_t* buffers[2] = {
+        s->line_buffers + (size_t)t * 2 * row_words + 1,
+        s->line_buffers + ((size_t)t * 2 + 1) * row_words + 1,
+    };
+
+    for (int round = 0;; round++) {
+        int64_t* removed = s->removed[round & 1];
+        const int64_t* last = s->removed[(round + 1) & 1];
+
+        // Halo exchange: bands that changed republish their edge rows
+        for (int b = t; b < n; b += workers) {
+            if (round > 0 && !last[b]) continue;
+            int end = (b + 1) * BAND_ROWS < s->g->rows ? (b + 1) * BAND_ROWS : s->g->rows;
+            memcpy(halo_row(s, b, 0), grid_row(s->g, b * BAND_ROWS), s->width * sizeof(uint64_t));
+            memcpy(halo_row(s, b, 1), grid_row(s->g, end - 1), s->width * sizeof(uint64_t));
+        }
+        barrier_wait(&s->barrier);
+
+        for (int b = t; b < n; b += workers) {
+            bool active = round == 0 || last[b] || (b > 0 && last[b - 1]) || (b + 1 < n && last[b + 1]);
+            removed[b] = active ? stencil_band(s, b, buffers) : 0;
+        }
+        barrier_wait(&s->barrier);
+
+        // Every worker sees the same counts and stops on the same round
+        int64_t round_removed = 0;
+        for (int b = 0; b < n; b++) {
+            round_removed += removed[b];
+        }
+        if (round_removed == 0) break;
+
+        if (t == 0) {
+            if (s->rounds) {
+                if (s->num_rounds >= s->capacity) {
+                    s->capacity *= 2;
+                    s->rounds = realloc(s->rounds, s->capacity * sizeof(int64_t));
                 }
+                s->rounds[s->num_rounds] = round_removed;
             }
+            s->num_rounds++;
+            s->total += round_removed;
         }
+    }
+}
+
+static void* stencil_thread(void* arg) {
+    StencilWorker* worker = arg;
+    stencil_run(worker->stencil, worker->index);
+    return NULL;
+}
+
+// Same contract as run_cascade, for grids too big for per-cell counts
+static int run_stencil(BitGrid* g, int64_t* total, int64_t** rounds) {
+    Stencil s = {
+        .g = g,
+        .width = grid_width(g),
+        .num_bands = grid_bands(g),
+        .capacity = 16,
+    };
+    int planned = parallel_threads() < s.num_bands ? parallel_threads() : s.num_bands;
+    if (planned < 1) planned = 1;
 
-        if (remove_count == 0) break;
+    s.halos = calloc((size_t)s.num_bands * 2 * g->stride, sizeof(uint64_t));
+    s.line_buffers = calloc((size_t)planned * 2 * g->stride, sizeof(uint64_t));
+    s.removed[0] = calloc(s.num_bands > 0 ? s.num_bands : 1, sizeof(int64_t));
+    s.removed[1] = calloc(s.num_bands > 0 ? s.num_bands : 1, sizeof(int64_t));
+    s.rounds = rounds ? malloc(s.capacity * sizeof(int64_t)) : NULL;
+    barrier_init(&s.barrier, planned);
 
-        for (int i = 0; i < remove_count; i++) {
-            int row = to_remove[i * 2];
-            int col = to_remove[i * 2 + 1];
-            g.grid[row][col] = '.';
+    // Workers are numbered contiguously from 1 however many start
+    pthread_t* tids = malloc(planned * sizeof(pthread_t));
+    StencilWorker* workers = malloc(planned * sizeof(StencilWorker));
+    int created = 0;
+    for (int t = 1; t < planned; t++) {
+        workers[created] = (StencilWorker){ .stencil = &s, .index = created + 1 };
+        if (pthread_create(&tids[created], NULL, stencil_thread, &workers[created]) == 0) {
+            created++;
+        } else {
+            barrier_leave(&s.barrier);
         }
-        total_removed += remove_count;
+    }
+    s.workers = created + 1;
+    stencil_run(&s, 0);
+    for (int t = 0; t < created; t++) {
+        pthread_join(tids[t], NULL);
     }
 
-    free(to_remove);
-    free_grid(&g);
+    *total = s.total;
+    if (rounds) *rounds = s.rounds;
+    barrier_destroy(&s.barrier);
+    free(workers);
+    free(tids);
+    free(s.removed[0]);
+    free(s.removed[1]);
+    free(s.line_buffers);
+    free(s.halos);
+    return s.num_rounds;
+}
+
+// Removal rounds with whichever engine suits the grid size
+static int remove_rolls(BitGrid* g, Arena* arena, int64_t* total, int64_t** rounds) {
+    if (fast_path((int64_t)g->rows * g->cols, STENCIL_MIN_CELLS)) {
+        return run_stencil(g, total, rounds);
+    }
+    return run_cascade(g, arena, total, rounds);
+}
+
+// Removes rolls from the grid in place; runs after part one
+static int64_t part_two(void* data, Arena* arena) {
+    int64_t total_removed;
+    remove_rolls(data, arena, &total_removed, NULL);
     return total_removed;
 }
 
-DayResult day04(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
+int day04_removal_rounds(const char* input, size_t len, int64_t** rounds) {
+    Arena arena;
+    arena_init(&arena);
+    BitGrid* g = parse_input(input, len, &arena);
+
+    int64_t total;
+    int num_rounds = remove_rolls(g, &arena, &total, rounds);
+
+    free_grid(g);
+    arena_destroy(&arena);
+    return num_rounds;
 }
+
+const DaySolver day04 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_grid,
+};
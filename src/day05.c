@@ -1,157 +1,174 @@
 // Day 5: Cafeteria - Range checking and merging
 
 #include "common.h"
+#include "days.h"
+
+#include <errno.h>
+#include <unistd.h>
 
 typedef struct {
-    int64_t start;
-    int64_t end;
-} Range;
-
-static void parse_input(const char* input, Range** ranges, int* range_count,
-                        int64_t** ids, int* id_count) {
-    // Find the blank line separator
-    const char* blank = strstr(input, "\n\n");
-    if (!blank) {
-        *range_count = 0;
-        *id_count = 0;
-        return;
-    }
+    IntervalIndex fresh;    // merged fresh ranges, shared by both parts
+    int64_t* ids;
+    int id_count;
+} Inventory;
 
-    // Parse ranges (first part)
-    int r_capacity = 16;
-    *ranges = malloc(r_capacity * sizeof(Range));
-    *range_count = 0;
-
-    const char* p = input;
-    while (p < blank) {
-        while (p < blank && (*p == ' ' || *p == '\n')) p++;
-        if (p >= blank) break;
-
-        int64_t start = 0;
-        while (p < blank && *p >= '0' && *p <= '9') {
-            start = start * 10 + (*p - '0');
-            p++;
-        }
+// Range index file shared across runs, or NULL
+static const char* index_path = NULL;
 
-        while (p < blank && *p == '-') p++;
+static bool index_missing(const char* path) {
+    return access(path, F_OK) != 0 && errno == ENOENT;
+}
 
-        int64_t end = 0;
-        while (p < blank && *p >= '0' && *p <= '9') {
-            end = end * 10 + (*p - '0');
-            p++;
-        }
+bool day05_set_index_file(const char* path) {
+    if (path && !index_missing(path)) {
+        IntervalIndex saved;
+        if (!interval_index_load(&saved, path)) return false;
+        interval_index_destroy(&saved);
+    }
+    index_path = path;
+    return true;
+}
 
-        if (*range_count >= r_capacity) {
+// "start-end" ranges in [p, end) (caller frees the array)
+static Interval* parse_ranges(const char* p, const char* end, int* count) {
+    int r_capacity = 16;
+    Interval* ranges = malloc(r_capacity * sizeof(Interval));
+    *count = 0;
+
+    uint64_t start, stop;
+    while (scan_uint(&p, end, &start) && scan_uint(&p, end, &stop)) {
+        if (*count >= r_capacity) {
             r_capacity *= 2;
-            *ranges = realloc(*ranges, r_capacity * sizeof(Range));
+            ranges = realloc(ranges, r_capacity * sizeof(Interval));
         }
-        (*ranges)[*range_count].start = start;
-        (*ranges)[*range_count].end = end;
-        (*range_count)++;
+        ranges[*count].start = start;
+        ranges[*count].end = stop;
+        (*count)++;
     }
 
-    // Parse IDs (second part)
-    int i_capacity = 16;
-    *ids = malloc(i_capacity * sizeof(int64_t));
-    *id_count = 0;
-
-    p = blank + 2;  // Skip "\n\n"
-    while (*p) {
-        while (*p && (*p == ' ' || *p == '\n')) p++;
-        if (!*p) break;
-
-        int64_t id = 0;
-        while (*p >= '0' && *p <= '9') {
-            id = id * 10 + (*p - '0');
-            p++;
-        }
+    return ranges;
+}
 
-        if (*id_count >= i_capacity) {
-            i_capacity *= 2;
-            *ids = realloc(*ids, i_capacity * sizeof(int64_t));
-        }
-        (*ids)[(*id_count)++] = id;
+// "12-18" and nothing else
+static bool is_range_line(Span line) {
+    const char* end = line.ptr + line.len;
+    const char* dash = scan_byte(line.ptr, end, '-');
+    if (dash == line.ptr || dash + 1 >= end) return false;
+    for (const char* p = line.ptr; p < end; p++) {
+        if (p != dash && (*p < '0' || *p > '9')) return false;
     }
+    return true;
 }
 
-static bool is_fresh(int64_t id, Range* ranges, int range_count) {
-    for (int i = 0; i < range_count; i++) {
-        if (id >= ranges[i].start && id <= ranges[i].end) {
-            return true;
-        }
+// End of the leading run of range lines: the blank line after them, or
+// input if the first line is not a range. A blank line only separates the
+// sections once ranges came before it, so a batch of IDs (even one that
+// ends in blank lines) never gets merged into the index as ranges.
+static const char* ranges_end(const char* input, size_t len) {
+    const char* end = input;
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line) && is_range_line(line)) {
+        end = line.ptr + line.len;
     }
-    return false;
+    return end;
 }
 
-static int64_t part_one(const char* input) {
-    Range* ranges;
-    int range_count;
-    int64_t* ids;
-    int id_count;
+// Start from the saved index (a new one if the file is missing), merge in
+// the input's ranges, and save it again if they added anything
+static void load_fresh_index(IntervalIndex* fresh, const Interval* ranges, int range_count) {
+    bool missing = index_missing(index_path);
+    if (missing) {
+        interval_index_build(fresh, NULL, 0);
+    } else if (!interval_index_load(fresh, index_path)) {
+        // Replaced since day05_set_index_file checked it: never overwrite
+        // it, just use this input's ranges
+        interval_index_build(fresh, ranges, range_count);
+        return;
+    }
 
-    parse_input(input, &ranges, &range_count, &ids, &id_count);
+    bool changed = range_count > 0 && interval_index_add(fresh, ranges, range_count);
+    if (missing || changed) interval_index_save(fresh, index_path);
+}
 
-    int64_t count = 0;
-    for (int i = 0; i < id_count; i++) {
-        if (is_fresh(ids[i], ranges, range_count)) {
-            count++;
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+
+    Inventory* inv = calloc(1, sizeof(Inventory));
+
+    // Ranges come first, up to the blank line. With an index file, input
+    // that doesn't start with ranges is just a batch of IDs to check
+    // against the saved ones.
+    const char* split = ranges_end(input, len);
+
+    // Parse ranges (first part)
+    int range_count = 0;
+    Interval* ranges = parse_ranges(input, split, &range_count);
+
+    // Sort and merge once; both parts query the index
+    if (index_path) {
+        load_fresh_index(&inv->fresh, ranges, range_count);
+    } else {
+        interval_index_build(&inv->fresh, ranges, range_count);
+    }
+    free(ranges);
+
+    // Parse IDs (second part)
+    int i_capacity = 16;
+    inv->ids = malloc(i_capacity * sizeof(int64_t));
+    inv->id_count = 0;
+
+    const char* p = split;
+    uint64_t id;
+    while (scan_uint(&p, input + len, &id)) {
+        if (inv->id_count >= i_capacity) {
+            i_capacity *= 2;
+            inv->ids = realloc(inv->ids, i_capacity * sizeof(int64_t));
         }
+        inv->ids[inv->id_count++] = id;
     }
 
-    free(ranges);
-    free(ids);
-    return count;
+    return inv;
 }
 
-static int compare_ranges(const void* a, const void* b) {
-    const Range* ra = (const Range*)a;
-    const Range* rb = (const Range*)b;
-    if (ra->start < rb->start) return -1;
-    if (ra->start > rb->start) return 1;
-    return 0;
+static void free_input(void* data) {
+    Inventory* inv = data;
+    interval_index_destroy(&inv->fresh);
+    free(inv->ids);
+    free(inv);
 }
 
-static int64_t part_two(const char* input) {
-    Range* ranges;
-    int range_count;
-    int64_t* ids;
-    int id_count;
-
-    parse_input(input, &ranges, &range_count, &ids, &id_count);
+// From this many IDs on, part one sorts them and sweeps the merged ranges
+// once instead of binary searching per ID
+#define SORTED_QUERY_MIN_IDS (1 << 19)
 
-    // Sort ranges by start
-    qsort(ranges, range_count, sizeof(Range), compare_ranges);
+// Sorts the IDs in place when there are many
+static int64_t part_one(void* data, Arena* arena) {
+    Inventory* inv = data;
 
-    // Merge overlapping ranges
-    Range* merged = malloc(range_count * sizeof(Range));
-    int merged_count = 0;
-
-    for (int i = 0; i < range_count; i++) {
-        if (merged_count > 0 && ranges[i].start <= merged[merged_count - 1].end + 1) {
-            // Merge with previous
-            if (ranges[i].end > merged[merged_count - 1].end) {
-                merged[merged_count - 1].end = ranges[i].end;
-            }
-        } else {
-            merged[merged_count++] = ranges[i];
-        }
+    if (fast_path(inv->id_count, SORTED_QUERY_MIN_IDS)) {
+        int64_t* scratch = arena_alloc(arena, inv->id_count * sizeof(int64_t));
+        radix_sort_i64(inv->ids, inv->id_count, scratch);
+        return interval_index_count_sorted(&inv->fresh, inv->ids, inv->id_count);
     }
 
-    // Count total IDs
-    int64_t total = 0;
-    for (int i = 0; i < merged_count; i++) {
-        total += merged[i].end - merged[i].start + 1;
+    int64_t count = 0;
+    for (int i = 0; i < inv->id_count; i++) {
+        count += interval_index_contains(&inv->fresh, inv->ids[i]);
     }
 
-    free(ranges);
-    free(ids);
-    free(merged);
-    return total;
+    return count;
 }
 
-DayResult day05(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
+    Inventory* inv = data;
+    return interval_index_total(&inv->fresh);
 }
+
+const DaySolver day05 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
@@ -8,6 +8,56 @@ typedef struct {
     int num_count;
 } Problem;
 
+// Input lines padded with spaces to a common width
+typedef struct {
+    char** padded;      // row pointers into text
+    char* text;
+    int line_count;
+    int max_len;
+} Worksheet;
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    Worksheet* ws = calloc(1, sizeof(Worksheet));
+
+    int line_count;
+    Span* lines = collect_lines(input, len, &line_count);
+    if (line_count == 0) {
+        free(lines);
+        return ws;
+    }
+
+    // Find max line length and pad all lines
+    int max_len = 0;
+    for (int i = 0; i < line_count; i++) {
+        if (lines[i].len > max_len) max_len = lines[i].len;
+    }
+
+    char* text = malloc((size_t)line_count * (max_len + 1));
+    char** padded = malloc(line_count * sizeof(char*));
+    for (int i = 0; i < line_count; i++) {
+        padded[i] = text + (size_t)i * (max_len + 1);
+        memcpy(padded[i], lines[i].ptr, lines[i].len);
+        memset(padded[i] + lines[i].len, ' ', max_len - lines[i].len);
+        padded[i][max_len] = '\0';
+    }
+
+    free(lines);
+
+    ws->padded = padded;
+    ws->text = text;
+    ws->line_count = line_count;
+    ws->max_len = max_len;
+    return ws;
+}
+
+static void free_input(void* data) {
+    Worksheet* ws = data;
+    free(ws->padded);
+    free(ws->text);
+    free(ws);
+}
+
 static int64_t solve_problem(Problem* p) {
     if (p->num_count == 0) return 0;
 
@@ -22,30 +72,15 @@ static int64_t solve_problem(Problem* p) {
     return result;
 }
 
-static Problem* parse_problems_v1(const char* input, int* count) {
-    int line_count;
-    char** lines = split_lines(input, &line_count);
+static Problem* parse_problems_v1(Worksheet* ws, int* count) {
+    char** padded = ws->padded;
+    int line_count = ws->line_count;
+    int max_len = ws->max_len;
     if (line_count == 0) {
         *count = 0;
         return NULL;
     }
 
-    // Find max line length and pad all lines
-    int max_len = 0;
-    for (int i = 0; i < line_count; i++) {
-        int len = strlen(lines[i]);
-        if (len > max_len) max_len = len;
-    }
-
-    char** padded = malloc(line_count * sizeof(char*));
-    for (int i = 0; i < line_count; i++) {
-        padded[i] = malloc(max_len + 1);
-        int len = strlen(lines[i]);
-        memcpy(padded[i], lines[i], len);
-        memset(padded[i] + len, ' ', max_len - len);
-        padded[i][max_len] = '\0';
-    }
-
     // Parse problems
     int capacity = 16;
     Problem* problems = malloc(capacity * sizeof(Problem));
@@ -92,29 +127,16 @@ static Problem* parse_problems_v1(const char* input, int* count) {
         p->num_count = 0;
 
         for (int i = 0; i < line_count; i++) {
-            char segment[256];
-            int seg_len = end_col - col;
-            memcpy(segment, padded[i] + col, seg_len);
-            segment[seg_len] = '\0';
-
-            // Trim
-            char* start = segment;
-            while (*start == ' ') start++;
-            char* end = start + strlen(start) - 1;
-            while (end > start && *end == ' ') end--;
-            *(end + 1) = '\0';
-
-            if (strcmp(start, "+") == 0) {
+            const char* seg = padded[i] + col;
+            const char* seg_end = padded[i] + end_col;
+
+            int64_t num;
+            if (scan_byte(seg, seg_end, '+') < seg_end) {
                 p->op = '+';
-            } else if (strcmp(start, "*") == 0) {
+            } else if (scan_byte(seg, seg_end, '*') < seg_end) {
                 p->op = '*';
-            } else if (*start) {
-                // Try to parse as number
-                char* endptr;
-                int64_t num = strtoll(start, &endptr, 10);
-                if (*endptr == '\0') {
-                    p->numbers[p->num_count++] = num;
-                }
+            } else if (scan_i64(&seg, seg_end, &num)) {
+                p->numbers[p->num_count++] = num;
             }
         }
 
@@ -127,19 +149,13 @@ static Problem* parse_problems_v1(const char* input, int* count) {
         col = end_col;
     }
 
-    // Cleanup
-    for (int i = 0; i < line_count; i++) {
-        free(padded[i]);
-    }
-    free(padded);
-    free_lines(lines, line_count);
-
     return problems;
 }
 
-static int64_t part_one(const char* input) {
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
     int count;
-    Problem* problems = parse_problems_v1(input, &count);
+    Problem* problems = parse_problems_v1(data, &count);
 
     int64_t sum = 0;
     for (int i = 0; i < count; i++) {
@@ -151,30 +167,14 @@ static int64_t part_one(const char* input) {
     return sum;
 }
 
-static Problem* parse_problems_v2(const char* input, int* count) {
-    int line_count;
-    char** lines = split_lines(input, &line_count);
+static Problem* parse_problems_v2(Worksheet* ws, int* count) {
+    char** padded = ws->padded;
+    int line_count = ws->line_count;
+    int max_len = ws->max_len;
     if (line_count == 0) {
         *count = 0;
         return NULL;
     }
-
-    // Find max line length and pad all lines
-    int max_len = 0;
-    for (int i = 0; i < line_count; i++) {
-        int len = strlen(lines[i]);
-        if (len > max_len) max_len = len;
-    }
-
-    char** padded = malloc(line_count * sizeof(char*));
-    for (int i = 0; i < line_count; i++) {
-        padded[i] = malloc(max_len + 1);
-        int len = strlen(lines[i]);
-        memcpy(padded[i], lines[i], len);
-        memset(padded[i] + len, ' ', max_len - len);
-        padded[i][max_len] = '\0';
-    }
-
     int num_rows = line_count;
 
     // Parse problems right to left
@@ -233,19 +233,19 @@ static Problem* parse_problems_v2(const char* input, int* count) {
 
         for (int c = col; c >= start_col; c--) {
             // Read digits vertically (top to bottom) from all rows except last
-            char num_str[64];
-            int num_len = 0;
+            int64_t num = 0;
+            bool has_digits = false;
 
             for (int r = 0; r < num_rows - 1; r++) {
                 char ch = padded[r][c];
                 if (ch >= '0' && ch <= '9') {
-                    num_str[num_len++] = ch;
+                    num = num * 10 + (ch - '0');
+                    has_digits = true;
                 }
             }
 
-            if (num_len > 0) {
-                num_str[num_len] = '\0';
-                p->numbers[p->num_count++] = strtoll(num_str, NULL, 10);
+            if (has_digits) {
+                p->numbers[p->num_count++] = num;
             }
         }
 
@@ -258,19 +258,13 @@ static Problem* parse_problems_v2(const char* input, int* count) {
         col = start_col;
     }
 
-    // Cleanup
-    for (int i = 0; i < line_count; i++) {
-        free(padded[i]);
-    }
-    free(padded);
-    free_lines(lines, line_count);
-
     return problems;
 }
 
-static int64_t part_two(const char* input) {
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
     int count;
-    Problem* problems = parse_problems_v2(input, &count);
+    Problem* problems = parse_problems_v2(data, &count);
 
     int64_t sum = 0;
     for (int i = 0; i < count; i++) {
@@ -282,9 +276,9 @@ static int64_t part_two(const char* input) {
     return sum;
 }
 
-DayResult day06(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
-}
+const DaySolver day06 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
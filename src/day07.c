@@ -4,26 +4,32 @@
 #include "common.h"
 
 typedef struct {
-    char** grid;
+    const char** grid;
     int rows;
     int cols;
     int start_col;
 } Grid;
 
-static Grid parse_input(const char* input) {
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
     int count;
-    char** lines = split_lines(input, &count);
+    Span* lines = collect_lines(input, len, &count);
 
-    Grid g;
-    g.grid = lines;
-    g.rows = count;
-    g.cols = (count > 0) ? strlen(lines[0]) : 0;
+    // Row pointers into the input; the grid is read-only
+    Grid* g = malloc(sizeof(Grid));
+    g->grid = malloc(count * sizeof(char*));
+    for (int r = 0; r < count; r++) {
+        g->grid[r] = lines[r].ptr;
+    }
+    g->rows = count;
+    g->cols = (count > 0) ? lines[0].len : 0;
+    free(lines);
 
     // Find S position
-    g.start_col = 0;
-    for (int c = 0; c < g.cols; c++) {
-        if (g.grid[0][c] == 'S') {
-            g.start_col = c;
+    g->start_col = 0;
+    for (int c = 0; c < g->cols; c++) {
+        if (g->grid[0][c] == 'S') {
+            g->start_col = c;
             break;
         }
     }
@@ -31,228 +37,114 @@ static Grid parse_input(const char* input) {
     return g;
 }
 
-// Simple hash set for (row, col) pairs
-#define BEAM_HASH_SIZE 4096
-
-typedef struct BeamNode {
-    int row;
-    int col;
-    struct BeamNode* next;
-} BeamNode;
-
-typedef struct {
-    BeamNode* buckets[BEAM_HASH_SIZE];
-    int count;
-} BeamSet;
-
-static void beamset_init(BeamSet* set) {
-    memset(set->buckets, 0, sizeof(set->buckets));
-    set->count = 0;
-}
-
-static void beamset_free(BeamSet* set) {
-    for (int i = 0; i < BEAM_HASH_SIZE; i++) {
-        BeamNode* node = set->buckets[i];
-        while (node) {
-            BeamNode* next = node->next;
-            free(node);
-            node = next;
-        }
-    }
-}
-
-static unsigned int beam_hash(int row, int col) {
-    return ((unsigned int)row * 31 + (unsigned int)col) % BEAM_HASH_SIZE;
+static void free_grid(void* data) {
+    Grid* g = data;
+    free(g->grid);
+    free(g);
 }
 
-static bool beamset_contains(BeamSet* set, int row, int col) {
-    unsigned int idx = beam_hash(row, col);
-    BeamNode* node = set->buckets[idx];
-    while (node) {
-        if (node->row == row && node->col == col) return true;
-        node = node->next;
-    }
-    return false;
+// Beams are keyed by (row, col) packed into one uint64
+static uint64_t beam_key(int row, int col) {
+    return (uint64_t)row << 32 | (uint32_t)col;
 }
 
-static void beamset_insert(BeamSet* set, int row, int col) {
-    if (beamset_contains(set, row, col)) return;
-    unsigned int idx = beam_hash(row, col);
-    BeamNode* node = malloc(sizeof(BeamNode));
-    node->row = row;
-    node->col = col;
-    node->next = set->buckets[idx];
-    set->buckets[idx] = node;
-    set->count++;
+static int beam_row(uint64_t key) {
+    return (int)(key >> 32);
 }
 
-// Get all beams as array
-static void beamset_to_array(BeamSet* set, int** rows, int** cols, int* count) {
-    *rows = malloc(set->count * sizeof(int));
-    *cols = malloc(set->count * sizeof(int));
-    *count = 0;
-
-    for (int i = 0; i < BEAM_HASH_SIZE; i++) {
-        BeamNode* node = set->buckets[i];
-        while (node) {
-            (*rows)[*count] = node->row;
-            (*cols)[*count] = node->col;
-            (*count)++;
-            node = node->next;
-        }
-    }
+static int beam_col(uint64_t key) {
+    return (int)(uint32_t)key;
 }
 
-static int64_t part_one(const char* input) {
-    Grid g = parse_input(input);
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
+    Grid* g = data;
 
-    BeamSet beams;
-    beamset_init(&beams);
-    beamset_insert(&beams, 0, g.start_col);
+    // Distinct beams on the current row and the next one, swapped each step
+    U64Map beams, new_beams;
+    u64map_init(&beams, g->cols);
+    u64map_init(&new_beams, g->cols);
+    u64map_insert(&beams, beam_key(0, g->start_col));
 
     int split_count = 0;
 
     while (beams.count > 0) {
-        int* rows;
-        int* cols;
-        int count;
-        beamset_to_array(&beams, &rows, &cols, &count);
-
-        BeamSet new_beams;
-        beamset_init(&new_beams);
+        u64map_clear(&new_beams);
 
-        for (int i = 0; i < count; i++) {
-            int row = rows[i];
-            int col = cols[i];
+        for (size_t i = 0; i < beams.count; i++) {
+            int row = beam_row(beams.keys[i]);
+            int col = beam_col(beams.keys[i]);
             int next_row = row + 1;
 
-            if (next_row >= g.rows) continue;
+            if (next_row >= g->rows) continue;
 
-            char cell = g.grid[next_row][col];
+            char cell = g->grid[next_row][col];
             if (cell == '^') {
                 split_count++;
-                if (col > 0) beamset_insert(&new_beams, next_row, col - 1);
-                if (col + 1 < g.cols) beamset_insert(&new_beams, next_row, col + 1);
+                if (col > 0) u64map_insert(&new_beams, beam_key(next_row, col - 1));
+                if (col + 1 < g->cols) u64map_insert(&new_beams, beam_key(next_row, col + 1));
             } else {
-                beamset_insert(&new_beams, next_row, col);
+                u64map_insert(&new_beams, beam_key(next_row, col));
             }
         }
 
-        free(rows);
-        free(cols);
-        beamset_free(&beams);
+        U64Map tmp = beams;
         beams = new_beams;
+        new_beams = tmp;
     }
 
-    beamset_free(&beams);
-    free_lines(g.grid, g.rows);
+    u64map_destroy(&beams);
+    u64map_destroy(&new_beams);
     return split_count;
 }
 
-// For part 2, track timeline counts per position
-#define TIMELINE_HASH_SIZE 4096
-
-typedef struct TimelineNode {
-    int row;
-    int col;
-    int64_t count;
-    struct TimelineNode* next;
-} TimelineNode;
-
-typedef struct {
-    TimelineNode* buckets[TIMELINE_HASH_SIZE];
-} TimelineMap;
-
-static void timelinemap_init(TimelineMap* map) {
-    memset(map->buckets, 0, sizeof(map->buckets));
-}
-
-static void timelinemap_free(TimelineMap* map) {
-    for (int i = 0; i < TIMELINE_HASH_SIZE; i++) {
-        TimelineNode* node = map->buckets[i];
-        while (node) {
-            TimelineNode* next = node->next;
-            free(node);
-            node = next;
-        }
-    }
-}
-
-static void timelinemap_add(TimelineMap* map, int row, int col, int64_t count) {
-    unsigned int idx = beam_hash(row, col);
-    TimelineNode* node = map->buckets[idx];
-    while (node) {
-        if (node->row == row && node->col == col) {
-            node->count += count;
-            return;
-        }
-        node = node->next;
-    }
-
-    node = malloc(sizeof(TimelineNode));
-    node->row = row;
-    node->col = col;
-    node->count = count;
-    node->next = map->buckets[idx];
-    map->buckets[idx] = node;
-}
-
-static bool timelinemap_empty(TimelineMap* map) {
-    for (int i = 0; i < TIMELINE_HASH_SIZE; i++) {
-        if (map->buckets[i]) return false;
-    }
-    return true;
-}
-
-static int64_t part_two(const char* input) {
-    Grid g = parse_input(input);
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
+    Grid* g = data;
 
-    TimelineMap beams;
-    timelinemap_init(&beams);
-    timelinemap_add(&beams, 0, g.start_col, 1);
+    // Timeline counts per beam position
+    U64Map beams, new_beams;
+    u64map_init(&beams, g->cols);
+    u64map_init(&new_beams, g->cols);
+    *u64map_get(&beams, beam_key(0, g->start_col)) = 1;
 
     int64_t total_timelines = 0;
 
-    while (!timelinemap_empty(&beams)) {
-        TimelineMap new_beams;
-        timelinemap_init(&new_beams);
+    while (beams.count > 0) {
+        u64map_clear(&new_beams);
 
-        for (int i = 0; i < TIMELINE_HASH_SIZE; i++) {
-            TimelineNode* node = beams.buckets[i];
-            while (node) {
-                int row = node->row;
-                int col = node->col;
-                int64_t count = node->count;
-                int next_row = row + 1;
+        for (size_t i = 0; i < beams.count; i++) {
+            int row = beam_row(beams.keys[i]);
+            int col = beam_col(beams.keys[i]);
+            int64_t count = beams.values[i];
+            int next_row = row + 1;
 
-                if (next_row >= g.rows) {
-                    total_timelines += count;
+            if (next_row >= g->rows) {
+                total_timelines += count;
+            } else {
+                char cell = g->grid[next_row][col];
+                if (cell == '^') {
+                    if (col > 0) *u64map_get(&new_beams, beam_key(next_row, col - 1)) += count;
+                    if (col + 1 < g->cols) *u64map_get(&new_beams, beam_key(next_row, col + 1)) += count;
                 } else {
-                    char cell = g.grid[next_row][col];
-                    if (cell == '^') {
-                        if (col > 0) timelinemap_add(&new_beams, next_row, col - 1, count);
-                        if (col + 1 < g.cols) timelinemap_add(&new_beams, next_row, col + 1, count);
-                    } else {
-                        timelinemap_add(&new_beams, next_row, col, count);
-                    }
+                    *u64map_get(&new_beams, beam_key(next_row, col)) += count;
                 }
-
-                node = node->next;
             }
         }
 
-        timelinemap_free(&beams);
+        U64Map tmp = beams;
         beams = new_beams;
+        new_beams = tmp;
     }
 
-    timelinemap_free(&beams);
-    free_lines(g.grid, g.rows);
+    u64map_destroy(&beams);
+    u64map_destroy(&new_beams);
     return total_timelines;
 }
 
-DayResult day07(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
-}
+const DaySolver day07 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_grid,
+};
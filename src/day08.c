@@ -77,29 +77,6 @@ static int compare_edges(const void* a, const void* b) {
     return 0;
 }
 
-static Point3D* parse_input(const char* input, int* count) {
-    int line_count;
-    char** lines = split_lines(input, &line_count);
-
-    Point3D* points = malloc(line_count * sizeof(Point3D));
-    *count = 0;
-
-    for (int i = 0; i < line_count; i++) {
-        if (!lines[i][0]) continue;
-
-        int64_t x, y, z;
-        if (sscanf(lines[i], "%ld,%ld,%ld", &x, &y, &z) == 3) {
-            points[*count].x = x;
-            points[*count].y = y;
-            points[*count].z = z;
-            (*count)++;
-        }
-    }
-
-    free_lines(lines, line_count);
-    return points;
-}
-
 static int64_t distance_squared(Point3D* a, Point3D* b) {
     int64_t dx = a->x - b->x;
     int64_t dy = a->y - b->y;
@@ -107,32 +84,83 @@ static int64_t distance_squared(Point3D* a, Point3D* b) {
     return dx * dx + dy * dy + dz * dz;
 }
 
-static int64_t solve(const char* input, int connections) {
+// Points plus all pairwise edges sorted by distance, shared by both parts
+typedef struct {
+    Point3D* points;
     int n;
-    Point3D* points = parse_input(input, &n);
+    Edge* edges;
+    size_t edge_count;
+} Playground;
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    int capacity = 1024;
+    Playground* pg = malloc(sizeof(Playground));
+    pg->points = malloc(capacity * sizeof(Point3D));
+    pg->n = 0;
+
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line)) {
+        if (line.len == 0) continue;
+
+        const char* p = line.ptr;
+        const char* end = line.ptr + line.len;
+        int64_t x, y, z;
+        if (scan_i64(&p, end, &x) && scan_i64(&p, end, &y) && scan_i64(&p, end, &z)) {
+            if (pg->n >= capacity) {
+                capacity *= 2;
+                pg->points = realloc(pg->points, capacity * sizeof(Point3D));
+            }
+            pg->points[pg->n].x = x;
+            pg->points[pg->n].y = y;
+            pg->points[pg->n].z = z;
+            pg->n++;
+        }
+    }
 
     // Calculate all pairwise distances
-    int num_edges = n * (n - 1) / 2;
-    Edge* edges = malloc(num_edges * sizeof(Edge));
-    int edge_count = 0;
+    int n = pg->n;
+    size_t num_edges = (size_t)n * (n - 1) / 2;
+    pg->edges = num_edges <= SIZE_MAX / sizeof(Edge) ? malloc(num_edges * sizeof(Edge)) : NULL;
+    pg->edge_count = 0;
+    if (num_edges > 0 && !pg->edges) {
+        fprintf(stderr, "Day 8: cannot allocate %zu edges for %d points\n", num_edges, n);
+        return pg;
+    }
 
     for (int i = 0; i < n; i++) {
         for (int j = i + 1; j < n; j++) {
-            edges[edge_count].dist = distance_squared(&points[i], &points[j]);
-            edges[edge_count].i = i;
-            edges[edge_count].j = j;
-            edge_count++;
+            pg->edges[pg->edge_count].dist = distance_squared(&pg->points[i], &pg->points[j]);
+            pg->edges[pg->edge_count].i = i;
+            pg->edges[pg->edge_count].j = j;
+            pg->edge_count++;
         }
     }
 
     // Sort by distance
-    qsort(edges, edge_count, sizeof(Edge), compare_edges);
+    qsort(pg->edges, pg->edge_count, sizeof(Edge), compare_edges);
+
+    return pg;
+}
+
+static void free_input(void* data) {
+    Playground* pg = data;
+    free(pg->edges);
+    free(pg->points);
+    free(pg);
+}
+
+static int64_t solve(Playground* pg, int connections) {
+    int n = pg->n;
+    Edge* edges = pg->edges;
+    size_t edge_count = pg->edge_count;
 
     // Connect the closest pairs
     UnionFind* uf = uf_create(n);
     int connected = 0;
 
-    for (int e = 0; e < edge_count && connected < connections; e++) {
+    for (size_t e = 0; e < edge_count && connected < connections; e++) {
         uf_union(uf, edges[e].i, edges[e].j);
         connected++;
     }
@@ -165,62 +193,45 @@ static int64_t solve(const char* input, int connections) {
 
     free(sizes);
     uf_free(uf);
-    free(edges);
-    free(points);
 
     return result;
 }
 
-static int64_t part_one(const char* input) {
-    return solve(input, 1000);
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
+    return solve(data, 1000);
 }
 
-static int64_t part_two(const char* input) {
-    int n;
-    Point3D* points = parse_input(input, &n);
-
-    // Calculate all pairwise distances
-    int num_edges = n * (n - 1) / 2;
-    Edge* edges = malloc(num_edges * sizeof(Edge));
-    int edge_count = 0;
-
-    for (int i = 0; i < n; i++) {
-        for (int j = i + 1; j < n; j++) {
-            edges[edge_count].dist = distance_squared(&points[i], &points[j]);
-            edges[edge_count].i = i;
-            edges[edge_count].j = j;
-            edge_count++;
-        }
-    }
-
-    // Sort by distance
-    qsort(edges, edge_count, sizeof(Edge), compare_edges);
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
+    Playground* pg = data;
+    int n = pg->n;
+    Edge* edges = pg->edges;
+    size_t edge_count = pg->edge_count;
 
     // Connect until all in one circuit
     UnionFind* uf = uf_create(n);
     int num_circuits = n;
     int64_t result = 0;
 
-    for (int e = 0; e < edge_count; e++) {
+    for (size_t e = 0; e < edge_count; e++) {
         if (uf_union(uf, edges[e].i, edges[e].j)) {
             num_circuits--;
             if (num_circuits == 1) {
-                result = points[edges[e].i].x * points[edges[e].j].x;
+                result = pg->points[edges[e].i].x * pg->points[edges[e].j].x;
                 break;
             }
         }
     }
 
     uf_free(uf);
-    free(edges);
-    free(points);
 
     return result;
 }
 
-DayResult day08(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
-}
+const DaySolver day08 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
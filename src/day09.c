@@ -6,26 +6,44 @@ typedef struct {
     int64_t x, y;
 } Point;
 
-static Point* parse_input(const char* input, int* count) {
-    int line_count;
-    char** lines = split_lines(input, &line_count);
-
-    Point* points = malloc(line_count * sizeof(Point));
-    *count = 0;
-
-    for (int i = 0; i < line_count; i++) {
-        if (!lines[i][0]) continue;
-
+typedef struct {
+    Point* tiles;
+    int n;
+} TileList;
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    int capacity = 1024;
+    TileList* list = malloc(sizeof(TileList));
+    list->tiles = malloc(capacity * sizeof(Point));
+    list->n = 0;
+
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line)) {
+        if (line.len == 0) continue;
+
+        const char* p = line.ptr;
+        const char* end = line.ptr + line.len;
         int64_t x, y;
-        if (sscanf(lines[i], "%ld,%ld", &x, &y) == 2) {
-            points[*count].x = x;
-            points[*count].y = y;
-            (*count)++;
+        if (scan_i64(&p, end, &x) && scan_i64(&p, end, &y)) {
+            if (list->n >= capacity) {
+                capacity *= 2;
+                list->tiles = realloc(list->tiles, capacity * sizeof(Point));
+            }
+            list->tiles[list->n].x = x;
+            list->tiles[list->n].y = y;
+            list->n++;
         }
     }
 
-    free_lines(lines, line_count);
-    return points;
+    return list;
+}
+
+static void free_input(void* data) {
+    TileList* list = data;
+    free(list->tiles);
+    free(list);
 }
 
 static int64_t i64_abs(int64_t x) {
@@ -40,9 +58,11 @@ static int64_t i64_min(int64_t a, int64_t b) {
     return a < b ? a : b;
 }
 
-static int64_t part_one(const char* input) {
-    int n;
-    Point* tiles = parse_input(input, &n);
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
+    TileList* list = data;
+    Point* tiles = list->tiles;
+    int n = list->n;
 
     int64_t max_area = 0;
 
@@ -55,7 +75,6 @@ static int64_t part_one(const char* input) {
         }
     }
 
-    free(tiles);
     return max_area;
 }
 
@@ -149,9 +168,11 @@ static bool is_rect_fully_inside(Point* tiles, int n, int64_t lx, int64_t rx, in
     return true;
 }
 
-static int64_t part_two(const char* input) {
-    int n;
-    Point* tiles = parse_input(input, &n);
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
+    TileList* list = data;
+    Point* tiles = list->tiles;
+    int n = list->n;
 
     int64_t max_area = 0;
 
@@ -169,13 +190,12 @@ static int64_t part_two(const char* input) {
         }
     }
 
-    free(tiles);
     return max_area;
 }
 
-DayResult day09(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
-}
+const DaySolver day09 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
@@ -12,14 +12,15 @@ typedef struct {
     int num_joltage;
 } PuzzleLine;
 
-static PuzzleLine parse_line(const char* line) {
+static PuzzleLine parse_line(Span line) {
     PuzzleLine p = {0};
+    const char* line_end = line.ptr + line.len;
 
     // Find brackets for lights [.##.]
-    const char* bracket_start = strchr(line, '[');
-    const char* bracket_end = strchr(line, ']');
+    const char* bracket_start = scan_byte(line.ptr, line_end, '[');
+    const char* bracket_end = scan_byte(line.ptr, line_end, ']');
 
-    if (bracket_start && bracket_end) {
+    if (bracket_start < line_end && bracket_end < line_end) {
         int len = bracket_end - bracket_start - 1;
         p.num_lights = len;
         p.lights = malloc(len * sizeof(bool));
@@ -34,25 +35,18 @@ static PuzzleLine parse_line(const char* line) {
     p.button_sizes = malloc(btn_capacity * sizeof(int));
     p.num_buttons = 0;
 
-    const char* ptr = bracket_end + 1;
-    while (*ptr && *ptr != '{') {
+    const char* ptr = bracket_end < line_end ? bracket_end + 1 : line.ptr;
+    while (ptr < line_end && *ptr != '{') {
         if (*ptr == '(') {
-            const char* paren_end = strchr(ptr, ')');
-            if (paren_end) {
+            const char* paren_end = scan_byte(ptr, line_end, ')');
+            if (paren_end < line_end) {
                 // Parse indices
                 int indices[32];
                 int idx_count = 0;
 
                 const char* ip = ptr + 1;
-                while (ip < paren_end) {
-                    while (ip < paren_end && (*ip == ' ' || *ip == ',')) ip++;
-                    if (ip >= paren_end) break;
-
-                    int num = 0;
-                    while (ip < paren_end && *ip >= '0' && *ip <= '9') {
-                        num = num * 10 + (*ip - '0');
-                        ip++;
-                    }
+                int num;
+                while (idx_count < 32 && scan_int(&ip, paren_end, &num)) {
                     indices[idx_count++] = num;
                 }
 
@@ -77,25 +71,17 @@ static PuzzleLine parse_line(const char* line) {
     }
 
     // Parse joltage {x,y,z}
-    const char* brace_start = strchr(line, '{');
-    const char* brace_end = strchr(line, '}');
+    const char* brace_start = scan_byte(line.ptr, line_end, '{');
+    const char* brace_end = scan_byte(line.ptr, line_end, '}');
 
-    if (brace_start && brace_end) {
+    if (brace_start < line_end && brace_end < line_end) {
         int jolt_capacity = 8;
         p.joltage = malloc(jolt_capacity * sizeof(int64_t));
         p.num_joltage = 0;
 
         const char* jp = brace_start + 1;
-        while (jp < brace_end) {
-            while (jp < brace_end && (*jp == ' ' || *jp == ',')) jp++;
-            if (jp >= brace_end) break;
-
-            int64_t num = 0;
-            while (jp < brace_end && *jp >= '0' && *jp <= '9') {
-                num = num * 10 + (*jp - '0');
-                jp++;
-            }
-
+        uint64_t num;
+        while (scan_uint(&jp, brace_end, &num)) {
             if (p.num_joltage >= jolt_capacity) {
                 jolt_capacity *= 2;
                 p.joltage = realloc(p.joltage, jolt_capacity * sizeof(int64_t));
@@ -117,17 +103,55 @@ static void free_puzzle_line(PuzzleLine* p) {
     free(p->joltage);
 }
 
+typedef struct {
+    PuzzleLine* machines;
+    int count;
+} Factory;
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    int capacity = 64;
+    Factory* f = malloc(sizeof(Factory));
+    f->machines = malloc(capacity * sizeof(PuzzleLine));
+    f->count = 0;
+
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line)) {
+        if (line.len == 0) continue;
+
+        if (f->count >= capacity) {
+            capacity *= 2;
+            f->machines = realloc(f->machines, capacity * sizeof(PuzzleLine));
+        }
+        f->machines[f->count++] = parse_line(line);
+    }
+
+    return f;
+}
+
+static void free_input(void* data) {
+    Factory* f = data;
+    for (int i = 0; i < f->count; i++) {
+        free_puzzle_line(&f->machines[i]);
+    }
+    free(f->machines);
+    free(f);
+}
+
 // Solve lights puzzle using brute force
-static int solve_machine(PuzzleLine* p) {
+static int solve_machine(PuzzleLine* p, Arena* arena) {
     int n_lights = p->num_lights;
     int n_buttons = p->num_buttons;
 
     if (n_buttons > 20) return 0;  // Too many for brute force
 
     int min_presses = INT_MAX;
+    ArenaMark mark = arena_mark(arena);
+    bool* state = arena_alloc(arena, n_lights * sizeof(bool));
 
     for (int mask = 0; mask < (1 << n_buttons); mask++) {
-        bool* state = calloc(n_lights, sizeof(bool));
+        memset(state, 0, n_lights * sizeof(bool));
         int presses = 0;
 
         for (int i = 0; i < n_buttons; i++) {
@@ -153,27 +177,23 @@ static int solve_machine(PuzzleLine* p) {
         if (matches && presses < min_presses) {
             min_presses = presses;
         }
-
-        free(state);
     }
 
+    arena_release(arena, mark);
+
     return min_presses == INT_MAX ? 0 : min_presses;
 }
 
-static int64_t part_one(const char* input) {
-    int line_count;
-    char** lines = split_lines(input, &line_count);
-
-    int64_t sum = 0;
-    for (int i = 0; i < line_count; i++) {
-        if (!lines[i][0]) continue;
-
-        PuzzleLine p = parse_line(lines[i]);
-        sum += solve_machine(&p);
-        free_puzzle_line(&p);
-    }
+static void sum_lights(void* ctx, int i, Arena* scratch, int64_t* sums) {
+    Factory* f = ctx;
+    sums[0] += solve_machine(&f->machines[i], scratch);
+}
 
-    free_lines(lines, line_count);
+// Machines are independent, so they are solved in parallel
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
+    int64_t sum;
+    parallel_sum(((Factory*)data)->count, 1, 1, sum_lights, data, &sum);
     return sum;
 }
 
@@ -255,16 +275,19 @@ static void search_solution(int64_t** matrix, int* pivot_cols, int pivot_count,
 }
 
 // Solve joltage puzzle (integer linear programming)
-static int64_t solve_joltage(PuzzleLine* p) {
+static int64_t solve_joltage(PuzzleLine* p, Arena* arena) {
     int n_counters = p->num_joltage;
     int n_buttons = p->num_buttons;
 
     if (n_counters == 0 || n_buttons == 0) return 0;
 
+    // All scratch for this machine comes from the arena
+    ArenaMark mark = arena_mark(arena);
+
     // Build coefficient matrix
-    int64_t** a = malloc(n_counters * sizeof(int64_t*));
+    int64_t** a = arena_alloc(arena, n_counters * sizeof(int64_t*));
     for (int j = 0; j < n_counters; j++) {
-        a[j] = calloc(n_buttons, sizeof(int64_t));
+        a[j] = arena_calloc(arena, n_buttons, sizeof(int64_t));
     }
 
     for (int i = 0; i < n_buttons; i++) {
@@ -277,9 +300,9 @@ static int64_t solve_joltage(PuzzleLine* p) {
     }
 
     // Build augmented matrix [A | b]
-    int64_t** matrix = malloc(n_counters * sizeof(int64_t*));
+    int64_t** matrix = arena_alloc(arena, n_counters * sizeof(int64_t*));
     for (int j = 0; j < n_counters; j++) {
-        matrix[j] = malloc((n_buttons + 1) * sizeof(int64_t));
+        matrix[j] = arena_alloc(arena, (n_buttons + 1) * sizeof(int64_t));
         for (int i = 0; i < n_buttons; i++) {
             matrix[j][i] = a[j][i];
         }
@@ -287,7 +310,7 @@ static int64_t solve_joltage(PuzzleLine* p) {
     }
 
     // Gaussian elimination
-    int* pivot_cols = malloc(n_buttons * sizeof(int));
+    int* pivot_cols = arena_alloc(arena, n_buttons * sizeof(int));
     int pivot_count = 0;
     int pivot_row = 0;
 
@@ -330,24 +353,18 @@ static int64_t solve_joltage(PuzzleLine* p) {
     for (int row = pivot_row; row < n_counters; row++) {
         if (matrix[row][n_buttons] != 0) {
             // No solution
-            for (int j = 0; j < n_counters; j++) {
-                free(matrix[j]);
-                free(a[j]);
-            }
-            free(matrix);
-            free(a);
-            free(pivot_cols);
+            arena_release(arena, mark);
             return 0;
         }
     }
 
     // Free variables
-    bool* is_pivot = calloc(n_buttons, sizeof(bool));
+    bool* is_pivot = arena_calloc(arena, n_buttons, sizeof(bool));
     for (int i = 0; i < pivot_count; i++) {
         is_pivot[pivot_cols[i]] = true;
     }
 
-    int* free_cols = malloc(n_buttons * sizeof(int));
+    int* free_cols = arena_alloc(arena, n_buttons * sizeof(int));
     int free_count = 0;
     for (int c = 0; c < n_buttons; c++) {
         if (!is_pivot[c]) {
@@ -363,47 +380,32 @@ static int64_t solve_joltage(PuzzleLine* p) {
     }
     if (max_search < 50) max_search = 50;
 
-    int64_t* solution = calloc(n_buttons, sizeof(int64_t));
+    int64_t* solution = arena_calloc(arena, n_buttons, sizeof(int64_t));
 
     // Use recursive search with pruning
     search_solution(matrix, pivot_cols, pivot_count, free_cols, free_count,
                    n_buttons, 0, solution, max_search, &min_presses, 0);
 
-    // Cleanup
-    free(solution);
-    free(free_cols);
-    free(is_pivot);
-    free(pivot_cols);
-    for (int j = 0; j < n_counters; j++) {
-        free(matrix[j]);
-        free(a[j]);
-    }
-    free(matrix);
-    free(a);
+    arena_release(arena, mark);
 
     return min_presses == INT64_MAX ? 0 : min_presses;
 }
 
-static int64_t part_two(const char* input) {
-    int line_count;
-    char** lines = split_lines(input, &line_count);
-
-    int64_t sum = 0;
-    for (int i = 0; i < line_count; i++) {
-        if (!lines[i][0]) continue;
-
-        PuzzleLine p = parse_line(lines[i]);
-        sum += solve_joltage(&p);
-        free_puzzle_line(&p);
-    }
+static void sum_joltage(void* ctx, int i, Arena* scratch, int64_t* sums) {
+    Factory* f = ctx;
+    sums[0] += solve_joltage(&f->machines[i], scratch);
+}
 
-    free_lines(lines, line_count);
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
+    int64_t sum;
+    parallel_sum(((Factory*)data)->count, 1, 1, sum_joltage, data, &sum);
     return sum;
 }
 
-DayResult day10(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
-}
+const DaySolver day10 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
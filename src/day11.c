@@ -24,11 +24,13 @@ static void graph_init(Graph* g) {
     g->num_nodes = 0;
 }
 
-static void graph_free(Graph* g) {
+static void graph_free(void* data) {
+    Graph* g = data;
     for (int i = 0; i < g->num_nodes; i++) {
         free(g->nodes[i].neighbors);
     }
     free(g->nodes);
+    free(g);
 }
 
 static int find_or_add_node(Graph* g, const char* name) {
@@ -61,23 +63,25 @@ static void add_neighbor(Graph* g, int from_idx, int to_idx) {
     node->neighbors[node->num_neighbors++] = to_idx;
 }
 
-static void parse_input(Graph* g, const char* input) {
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    Graph* g = malloc(sizeof(Graph));
     graph_init(g);
 
-    int line_count;
-    char** lines = split_lines(input, &line_count);
+    LineIter it = lines_begin(input, len);
+    Span line;
+    while (lines_next(&it, &line)) {
+        if (line.len == 0 || line.ptr[0] == '#') continue;
 
-    for (int i = 0; i < line_count; i++) {
-        if (!lines[i][0] || lines[i][0] == '#') continue;
-
-        char* colon = strchr(lines[i], ':');
-        if (!colon) continue;
+        const char* end = line.ptr + line.len;
+        const char* colon = scan_byte(line.ptr, end, ':');
+        if (colon == end) continue;
 
         // Parse "from" node
         char from_name[MAX_NAME_LEN];
-        int from_len = colon - lines[i];
+        int from_len = colon - line.ptr;
         if (from_len >= MAX_NAME_LEN) from_len = MAX_NAME_LEN - 1;
-        strncpy(from_name, lines[i], from_len);
+        memcpy(from_name, line.ptr, from_len);
         from_name[from_len] = '\0';
 
         // Trim trailing spaces
@@ -88,14 +92,14 @@ static void parse_input(Graph* g, const char* input) {
         int from_idx = find_or_add_node(g, from_name);
 
         // Parse neighbors
-        char* ptr = colon + 1;
-        while (*ptr) {
-            while (*ptr && (*ptr == ' ' || *ptr == '\t')) ptr++;
-            if (!*ptr) break;
+        const char* ptr = colon + 1;
+        while (ptr < end) {
+            while (ptr < end && (*ptr == ' ' || *ptr == '\t')) ptr++;
+            if (ptr >= end) break;
 
             char to_name[MAX_NAME_LEN];
             int to_len = 0;
-            while (*ptr && *ptr != ' ' && *ptr != '\t' && *ptr != '\n' && to_len < MAX_NAME_LEN - 1) {
+            while (ptr < end && *ptr != ' ' && *ptr != '\t' && to_len < MAX_NAME_LEN - 1) {
                 to_name[to_len++] = *ptr++;
             }
             to_name[to_len] = '\0';
@@ -107,7 +111,7 @@ static void parse_input(Graph* g, const char* input) {
         }
     }
 
-    free_lines(lines, line_count);
+    return g;
 }
 
 static int64_t count_paths_dfs(Graph* g, int current, int target, int64_t* memo) {
@@ -164,25 +168,19 @@ static int64_t count_paths_via_two(Graph* g, const char* from, const char* to,
     return p1 + p2;
 }
 
-static int64_t part_one(const char* input) {
-    Graph g;
-    parse_input(&g, input);
-    int64_t result = count_paths(&g, "you", "out");
-    graph_free(&g);
-    return result;
+static int64_t part_one(void* data, Arena* arena) {
+    (void)arena;
+    return count_paths(data, "you", "out");
 }
 
-static int64_t part_two(const char* input) {
-    Graph g;
-    parse_input(&g, input);
-    int64_t result = count_paths_via_two(&g, "svr", "out", "dac", "fft");
-    graph_free(&g);
-    return result;
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
+    return count_paths_via_two(data, "svr", "out", "dac", "fft");
 }
 
-DayResult day11(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
-}
+const DaySolver day11 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = graph_free,
+};
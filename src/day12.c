@@ -154,7 +154,7 @@ static void unplace_shape(bool** grid, Shape* shape, int row, int col) {
 }
 
 static bool solve(bool** grid, int width, int height, ShapeSet* pieces, int num_pieces,
-                  int* remaining, int num_remaining, int empty_budget) {
+                  int* remaining, int num_remaining, int empty_budget, Arena* arena) {
     if (num_remaining == 0) return true;
 
     // Find first empty cell
@@ -171,7 +171,10 @@ static bool solve(bool** grid, int width, int height, ShapeSet* pieces, int num_
 
     if (start_row < 0) return num_remaining == 0;
 
-    // Try each remaining piece to cover the first empty cell
+    // Try each remaining piece to cover the first empty cell; the list of
+    // pieces left for the next level is rebuilt in one arena buffer
+    ArenaMark mark = arena_mark(arena);
+    int* new_remaining = arena_alloc(arena, (num_remaining - 1) * sizeof(int));
     bool any_placed = false;
     for (int i = 0; i < num_remaining; i++) {
         int piece_idx = remaining[i];
@@ -189,27 +192,28 @@ static bool solve(bool** grid, int width, int height, ShapeSet* pieces, int num_
                     place_shape(grid, shape, row, col);
 
                     // Remove piece from remaining
-                    int* new_remaining = malloc((num_remaining - 1) * sizeof(int));
                     for (int j = 0, k = 0; j < num_remaining; j++) {
                         if (j != i) new_remaining[k++] = remaining[j];
                     }
 
-                    if (solve(grid, width, height, pieces, num_pieces, new_remaining, num_remaining - 1, empty_budget)) {
-                        free(new_remaining);
+                    if (solve(grid, width, height, pieces, num_pieces, new_remaining, num_remaining - 1,
+                              empty_budget, arena)) {
+                        arena_release(arena, mark);
                         return true;
                     }
 
-                    free(new_remaining);
                     unplace_shape(grid, shape, row, col);
                 }
             }
         }
     }
 
+    arena_release(arena, mark);
+
     // If no piece can cover this cell and we have empty budget
     if (!any_placed && empty_budget > 0) {
         grid[start_row][start_col] = true;
-        if (solve(grid, width, height, pieces, num_pieces, remaining, num_remaining, empty_budget - 1)) {
+        if (solve(grid, width, height, pieces, num_pieces, remaining, num_remaining, empty_budget - 1, arena)) {
             return true;
         }
         grid[start_row][start_col] = false;
@@ -218,7 +222,8 @@ static bool solve(bool** grid, int width, int height, ShapeSet* pieces, int num_
     return false;
 }
 
-static bool can_fit(ShapeSet* all_orientations, int num_shapes, int width, int height, int* counts, int num_counts) {
+static bool can_fit(ShapeSet* all_orientations, int num_shapes, int width, int height,
+                    int* counts, int num_counts, Arena* arena) {
     // Collect all pieces
     int total_pieces = 0;
     int total_cells = 0;
@@ -232,9 +237,11 @@ static bool can_fit(ShapeSet* all_orientations, int num_shapes, int width, int h
 
     if (total_cells > width * height) return false;
 
+    ArenaMark mark = arena_mark(arena);
+
     // Build pieces array
-    ShapeSet* pieces = malloc(total_pieces * sizeof(ShapeSet));
-    int* piece_sizes = malloc(total_pieces * sizeof(int));
+    ShapeSet* pieces = arena_alloc(arena, total_pieces * sizeof(ShapeSet));
+    int* piece_sizes = arena_alloc(arena, total_pieces * sizeof(int));
     int piece_count = 0;
 
     for (int i = 0; i < num_counts && i < num_shapes; i++) {
@@ -260,32 +267,36 @@ static bool can_fit(ShapeSet* all_orientations, int num_shapes, int width, int h
     }
 
     // Create grid
-    bool** grid = malloc(height * sizeof(bool*));
+    bool** grid = arena_alloc(arena, height * sizeof(bool*));
     for (int r = 0; r < height; r++) {
-        grid[r] = calloc(width, sizeof(bool));
+        grid[r] = arena_calloc(arena, width, sizeof(bool));
     }
 
-    int* remaining = malloc(piece_count * sizeof(int));
+    int* remaining = arena_alloc(arena, piece_count * sizeof(int));
     for (int i = 0; i < piece_count; i++) {
         remaining[i] = i;
     }
 
     int empty_budget = width * height - total_cells;
-    bool result = solve(grid, width, height, pieces, piece_count, remaining, piece_count, empty_budget);
-
-    // Cleanup
-    for (int r = 0; r < height; r++) {
-        free(grid[r]);
-    }
-    free(grid);
-    free(remaining);
-    free(pieces);
-    free(piece_sizes);
+    bool result = solve(grid, width, height, pieces, piece_count, remaining, piece_count,
+                        empty_budget, arena);
 
+    arena_release(arena, mark);
     return result;
 }
 
-static int64_t part_one(const char* input) {
+typedef struct {
+    Shape* shapes;
+    ShapeSet* all_orientations;
+    int num_shapes;
+    Region* regions;
+    int num_regions;
+} Farm;
+
+static void* parse_input(const char* input, size_t len, Arena* arena) {
+    (void)arena;
+    const char* end = input + len;
+
     // Parse shapes and regions
     Shape* shapes = malloc(16 * sizeof(Shape));
     int num_shapes = 0;
@@ -347,42 +358,19 @@ static int64_t part_one(const char* input) {
             } else if (x_pos) {
                 // This is a region definition (e.g., "4x4: 0 0 0 0 2 0")
                 while (*p) {
-                    // Find 'x'
-                    while (*p && !(*p >= '0' && *p <= '9')) p++;
-                    if (!*p) break;
+                    const char* line_end = scan_byte(p, end, '\n');
 
-                    int width = 0;
-                    while (*p >= '0' && *p <= '9') {
-                        width = width * 10 + (*p - '0');
-                        p++;
-                    }
-
-                    if (*p != 'x') break;
-                    p++;
-
-                    int height = 0;
-                    while (*p >= '0' && *p <= '9') {
-                        height = height * 10 + (*p - '0');
-                        p++;
-                    }
-
-                    while (*p && *p == ':') p++;
+                    int width, height;
+                    if (!scan_int(&p, line_end, &width) || *p != 'x') break;
+                    if (!scan_int(&p, line_end, &height)) break;
 
                     // Parse counts
                     int* counts = malloc(16 * sizeof(int));
                     int count_count = 0;
                     int count_capacity = 16;
 
-                    while (*p && *p != '\n') {
-                        while (*p && (*p == ' ' || *p == '\t')) p++;
-                        if (!*p || *p == '\n') break;
-
-                        int num = 0;
-                        while (*p >= '0' && *p <= '9') {
-                            num = num * 10 + (*p - '0');
-                            p++;
-                        }
-
+                    int num;
+                    while (scan_int(&p, line_end, &num)) {
                         if (count_count >= count_capacity) {
                             count_capacity *= 2;
                             counts = realloc(counts, count_capacity * sizeof(int));
@@ -425,42 +413,60 @@ static int64_t part_one(const char* input) {
         all_orientations[i] = get_orientations(&shapes[i]);
     }
 
-    // Count regions that can be filled
-    int64_t count = 0;
-    for (int i = 0; i < num_regions; i++) {
-        if (can_fit(all_orientations, num_shapes, regions[i].width, regions[i].height,
-                    regions[i].counts, regions[i].num_counts)) {
-            count++;
+    Farm* farm = malloc(sizeof(Farm));
+    farm->shapes = shapes;
+    farm->all_orientations = all_orientations;
+    farm->num_shapes = num_shapes;
+    farm->regions = regions;
+    farm->num_regions = num_regions;
+    return farm;
+}
+
+static void free_input(void* data) {
+    Farm* farm = data;
+
+    for (int i = 0; i < farm->num_shapes; i++) {
+        free(farm->shapes[i].cells);
+        for (int j = 0; j < farm->all_orientations[i].num_orientations; j++) {
+            free(farm->all_orientations[i].orientations[j].cells);
         }
+        free(farm->all_orientations[i].orientations);
     }
+    free(farm->shapes);
+    free(farm->all_orientations);
 
-    // Cleanup
-    for (int i = 0; i < num_shapes; i++) {
-        free(shapes[i].cells);
-        for (int j = 0; j < all_orientations[i].num_orientations; j++) {
-            free(all_orientations[i].orientations[j].cells);
-        }
-        free(all_orientations[i].orientations);
+    for (int i = 0; i < farm->num_regions; i++) {
+        free(farm->regions[i].counts);
     }
-    free(shapes);
-    free(all_orientations);
+    free(farm->regions);
+    free(farm);
+}
 
-    for (int i = 0; i < num_regions; i++) {
-        free(regions[i].counts);
+static int64_t part_one(void* data, Arena* arena) {
+    Farm* farm = data;
+
+    // Count regions that can be filled
+    int64_t count = 0;
+    for (int i = 0; i < farm->num_regions; i++) {
+        Region* r = &farm->regions[i];
+        if (can_fit(farm->all_orientations, farm->num_shapes, r->width, r->height,
+                    r->counts, r->num_counts, arena)) {
+            count++;
+        }
     }
-    free(regions);
 
     return count;
 }
 
-static int64_t part_two(const char* input) {
-    (void)input;
+static int64_t part_two(void* data, Arena* arena) {
+    (void)arena;
+    (void)data;
     return 0;
 }
 
-DayResult day12(const char* input) {
-    return (DayResult){
-        .part1 = part_one(input),
-        .part2 = part_two(input)
-    };
-}
+const DaySolver day12 = {
+    .parse = parse_input,
+    .part1 = part_one,
+    .part2 = part_two,
+    .free = free_input,
+};
@@ -4,17 +4,45 @@
 #include "common.h"
 
 // Day solver declarations
-DayResult day01(const char* input);
-DayResult day02(const char* input);
-DayResult day03(const char* input);
-DayResult day04(const char* input);
-DayResult day05(const char* input);
-DayResult day06(const char* input);
-DayResult day07(const char* input);
-DayResult day08(const char* input);
-DayResult day09(const char* input);
-DayResult day10(const char* input);
-DayResult day11(const char* input);
-DayResult day12(const char* input);
+extern const DaySolver day01;
+extern const DaySolver day02;
+extern const DaySolver day03;
+extern const DaySolver day04;
+extern const DaySolver day05;
+extern const DaySolver day06;
+extern const DaySolver day07;
+extern const DaySolver day08;
+extern const DaySolver day09;
+extern const DaySolver day10;
+extern const DaySolver day11;
+extern const DaySolver day12;
+
+// Day 1 in one streaming pass over a file descriptor (file, pipe or stdin):
+// reads in fixed-size chunks and updates both parts together, so memory
+// use is constant however long the instruction log is
+DayResult day01_stream(int fd);
+
+// Day 4 removal cascade round by round: stores a malloc'd array with the
+// number of rolls removed in each synchronous round in *rounds and returns
+// the number of rounds (the caller frees the array)
+int day04_removal_rounds(const char* input, size_t len, int64_t** rounds);
+
+// Keep day 5's merged fresh ranges in an index file at path (NULL to stop).
+// Each parse loads the index instead of starting from scratch, merges in
+// the input's ranges, and saves it back if they changed it. An input that
+// doesn't start with "a-b" range lines is then read as IDs only, checked
+// against the saved ranges. Only a missing file is created: if something
+// else is at path and it doesn't load as an index, this prints why and
+// returns false, and the file is left alone.
+bool day05_set_index_file(const char* path);
+
+// Day 3 for any set of digit counts: sums[j] is the total over all banks
+// of the largest ks[j]-digit number that keeps digit order. All counts are
+// answered in the same pass over each bank. Values stay below 10^32, so
+// 128-bit sums are exact for millions of banks. False if a count is
+// outside [1, DAY03_MAX_DIGITS].
+#define DAY03_MAX_DIGITS 32
+
+bool day03_max_digit_sums(const char* input, size_t len, const int* ks, int num_ks, u128* sums);
 
 #endif // DAYS_H
@@ -1,59 +1,728 @@
 #include "common.h"
 #include "days.h"
 
-static DaySolver solvers[] = {
-    day01, day02, day03, day04, day05, day06,
-    day07, day08, day09, day10, day11, day12
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+static const DaySolver* solvers[] = {
+    &day01, &day02, &day03, &day04, &day05, &day06,
+    &day07, &day08, &day09, &day10, &day11, &day12
 };
 
 static const int NUM_DAYS = sizeof(solvers) / sizeof(solvers[0]);
 
-static void run_day(int day, bool use_example) {
-    char* input = use_example ? read_example(day) : read_input(day);
-    if (!input) {
-        printf("Day %02d: Input not found\n", day);
+// Compiler flags the runner was built with (passed in by the Makefile)
+#ifndef BUILD_CFLAGS
+#define BUILD_CFLAGS "unknown"
+#endif
+
+#if defined(__clang__)
+#define BUILD_COMPILER "clang " __clang_version__
+#elif defined(__GNUC__)
+#define BUILD_COMPILER "gcc " __VERSION__
+#else
+#define BUILD_COMPILER "unknown"
+#endif
+
+typedef struct {
+    int iterations;     // 0 = single timed run
+    int warmup;         // untimed runs before the measured ones
+} BenchConfig;
+
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_JSON,
+    FORMAT_CSV
+} OutputFormat;
+
+typedef struct {
+    const char* input_name;     // inputs/NN-<input_name>.txt
+    BenchConfig bench;
+    int jobs;
+    bool counters;
+    bool verify;                // compare answers with inputs/NN-<input_name>.answer
+    OutputFormat format;
+} RunOptions;
+
+typedef struct {
+    double min;
+    double median;
+    double p95;
+    double max;
+    double stddev;
+} BenchStats;
+
+static int compare_doubles(const void* a, const void* b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    if (da < db) return -1;
+    if (da > db) return 1;
+    return 0;
+}
+
+// Summarize samples (sorted in place)
+static BenchStats compute_stats(double* samples, int n) {
+    qsort(samples, n, sizeof(double), compare_doubles);
+
+    BenchStats s;
+    s.min = samples[0];
+    s.max = samples[n - 1];
+    s.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+
+    // Nearest-rank percentile
+    int p95_rank = (int)ceil(0.95 * n);
+    s.p95 = samples[p95_rank - 1];
+
+    double mean = 0.0;
+    for (int i = 0; i < n; i++) mean += samples[i];
+    mean /= n;
+
+    double var = 0.0;
+    for (int i = 0; i < n; i++) var += (samples[i] - mean) * (samples[i] - mean);
+    s.stddev = (n > 1) ? sqrt(var / (n - 1)) : 0.0;
+
+    return s;
+}
+
+static void print_phases(const DayTimings* t, const char* label) {
+    printf("        %sparse %.3f ms, part 1 %.3f ms, part 2 %.3f ms\n",
+           label, t->parse_ms, t->part1_ms, t->part2_ms);
+}
+
+// Per-run averages of the counters summed over runs
+static void print_counters(const PerfCounts* c, int runs) {
+    const uint64_t* v = c->values;
+    printf("       ");
+    if (c->valid[PERF_CYCLES]) {
+        printf(" %.3g cycles,", (double)v[PERF_CYCLES] / runs);
+    }
+    if (c->valid[PERF_CYCLES] && c->valid[PERF_INSTRUCTIONS] && v[PERF_CYCLES] > 0) {
+        printf(" IPC %.2f,", (double)v[PERF_INSTRUCTIONS] / v[PERF_CYCLES]);
+    }
+    if (c->valid[PERF_CACHE_REFS] && c->valid[PERF_CACHE_MISSES] && v[PERF_CACHE_REFS] > 0) {
+        printf(" cache misses %.2f%%,", 100.0 * v[PERF_CACHE_MISSES] / v[PERF_CACHE_REFS]);
+    }
+    if (c->valid[PERF_BRANCHES] && c->valid[PERF_BRANCH_MISSES] && v[PERF_BRANCHES] > 0) {
+        printf(" branch misses %.2f%%", 100.0 * v[PERF_BRANCH_MISSES] / v[PERF_BRANCHES]);
+    }
+    printf("\n");
+}
+
+static double time_solver(const DaySolver* solver, const InputView* input,
+                          Arena* arena, DayResult* result) {
+    int64_t start = clock_ns();
+    *result = run_solver(solver, input->data, input->len, arena);
+    int64_t end = clock_ns();
+    return (double)(end - start) / 1e6;
+}
+
+// One selected day: its input and the results of every measured run
+typedef struct {
+    int day;
+    InputView input;
+    int runs_left;          // guarded by Runner.lock
+    int warmups_left;       // guarded by Runner.lock
+    double* samples;
+    DayTimings* phases;
+    DayResult result;
+    PerfCounts counters;    // summed over measured runs
+    bool has_answers;       // expected answers loaded for --verify
+    int64_t expected[2];
+} DayJob;
+
+// A single solver run; iteration < 0 marks an untimed warmup run
+typedef struct {
+    DayJob* job;
+    int iteration;
+} Task;
+
+// Worker pool state: workers claim tasks in order by bumping next
+typedef struct {
+    Task* tasks;
+    int num_tasks;
+    atomic_int next;
+    bool counters;          // collect hardware counters per run
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+} Runner;
+
+static void* worker(void* arg) {
+    Runner* runner = arg;
+
+    // Scratch memory for the solvers, reused across runs
+    Arena arena;
+    arena_init(&arena);
+
+    PerfCounters pc;
+    if (runner->counters) perf_open(&pc);
+
+    for (;;) {
+        int i = atomic_fetch_add(&runner->next, 1);
+        if (i >= runner->num_tasks) break;
+
+        Task* task = &runner->tasks[i];
+        DayJob* job = task->job;
+
+        // Measured runs wait for the day's warmups, which other workers may
+        // still be running. They were queued first, so they are all claimed.
+        if (task->iteration >= 0) {
+            pthread_mutex_lock(&runner->lock);
+            while (job->warmups_left > 0) {
+                pthread_cond_wait(&runner->done, &runner->lock);
+            }
+            pthread_mutex_unlock(&runner->lock);
+        }
+
+        DayResult result;
+        if (runner->counters) perf_start(&pc);
+        double time_ms = time_solver(solvers[job->day - 1], &job->input, &arena, &result);
+        PerfCounts counts = {0};
+        if (runner->counters) counts = perf_stop(&pc);
+
+        pthread_mutex_lock(&runner->lock);
+        if (task->iteration >= 0) {
+            job->samples[task->iteration] = time_ms;
+            job->phases[task->iteration] = result.timings;
+            job->result = result;
+            for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+                job->counters.values[e] += counts.values[e];
+                job->counters.valid[e] = counts.valid[e];
+            }
+        } else {
+            job->warmups_left--;
+        }
+        job->runs_left--;
+        pthread_cond_broadcast(&runner->done);
+        pthread_mutex_unlock(&runner->lock);
+    }
+
+    if (runner->counters) perf_close(&pc);
+    arena_destroy(&arena);
+    return NULL;
+}
+
+static void print_day_text(const DayJob* job, const BenchConfig* bench, bool counters) {
+    const DayResult* result = &job->result;
+
+    if (bench->iterations == 0) {
+        printf("Day %02d: Part 1 = %lld, Part 2 = %lld (%.2f ms)\n",
+               job->day, (long long)result->part1, (long long)result->part2, job->samples[0]);
+        print_phases(&result->timings, "");
+        if (counters) print_counters(&job->counters, 1);
+        return;
+    }
+
+    int n = bench->iterations;
+    double* scratch = malloc(n * 4 * sizeof(double));
+    double* parse = scratch + n;
+    double* part1 = scratch + 2 * n;
+    double* part2 = scratch + 3 * n;
+    for (int i = 0; i < n; i++) {
+        scratch[i] = job->samples[i];
+        parse[i] = job->phases[i].parse_ms;
+        part1[i] = job->phases[i].part1_ms;
+        part2[i] = job->phases[i].part2_ms;
+    }
+
+    BenchStats s = compute_stats(scratch, n);
+    DayTimings median = {
+        .parse_ms = compute_stats(parse, n).median,
+        .part1_ms = compute_stats(part1, n).median,
+        .part2_ms = compute_stats(part2, n).median,
+    };
+    printf("Day %02d: Part 1 = %lld, Part 2 = %lld\n",
+           job->day, (long long)result->part1, (long long)result->part2);
+    printf("        min %.3f ms, median %.3f ms, p95 %.3f ms, max %.3f ms, stddev %.3f ms (%d runs)\n",
+           s.min, s.median, s.p95, s.max, s.stddev, n);
+    print_phases(&median, "median ");
+    if (counters) print_counters(&job->counters, n);
+
+    free(scratch);
+}
+
+typedef enum {
+    VERIFY_OK,
+    VERIFY_MISMATCH,
+    VERIFY_NO_ANSWERS,
+    VERIFY_NO_INPUT
+} VerifyStatus;
+
+static VerifyStatus verify_day(const DayJob* job) {
+    if (!job->input.data) return VERIFY_NO_INPUT;
+    if (!job->has_answers) return VERIFY_NO_ANSWERS;
+    if (job->result.part1 != job->expected[0] || job->result.part2 != job->expected[1]) {
+        return VERIFY_MISMATCH;
+    }
+    return VERIFY_OK;
+}
+
+static void print_verify_text(const DayJob* job, VerifyStatus status) {
+    switch (status) {
+    case VERIFY_OK:
+        printf("        verify: OK\n");
+        break;
+    case VERIFY_MISMATCH:
+        printf("        verify: MISMATCH, expected Part 1 = %lld, Part 2 = %lld\n",
+               (long long)job->expected[0], (long long)job->expected[1]);
+        break;
+    case VERIFY_NO_ANSWERS:
+        printf("        verify: FAILED, no expected answers\n");
+        break;
+    case VERIFY_NO_INPUT:
+        break;
+    }
+}
+
+static const char* const verify_names[] = {
+    [VERIFY_OK] = "ok",
+    [VERIFY_MISMATCH] = "mismatch",
+    [VERIFY_NO_ANSWERS] = "no answers",
+    [VERIFY_NO_INPUT] = "no input",
+};
+
+static void print_json_string(const char* s) {
+    putchar('"');
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            printf("\\%c", *s);
+        } else if ((unsigned char)*s < 0x20) {
+            printf("\\u%04x", *s);
+        } else {
+            putchar(*s);
+        }
+    }
+    putchar('"');
+}
+
+static void print_csv_string(const char* s) {
+    putchar('"');
+    for (; *s; s++) {
+        if (*s == '"') putchar('"');
+        putchar(*s);
+    }
+    putchar('"');
+}
+
+static const char* const perf_event_names[PERF_NUM_EVENTS] = {
+    [PERF_CYCLES] = "cycles",
+    [PERF_INSTRUCTIONS] = "instructions",
+    [PERF_CACHE_REFS] = "cache_references",
+    [PERF_CACHE_MISSES] = "cache_misses",
+    [PERF_BRANCHES] = "branches",
+    [PERF_BRANCH_MISSES] = "branch_misses",
+};
+
+// One element of the "days" array; counters are totals over all runs
+static void print_day_json(const DayJob* job, int runs, bool counters, bool verify, bool first) {
+    printf("%s    {\"day\": %d", first ? "" : ",\n", job->day);
+    if (!job->input.data) {
+        printf(", \"error\": \"input not found\"}");
+        return;
+    }
+
+    const DayResult* result = &job->result;
+    printf(", \"input_bytes\": %zu, \"part1\": %lld, \"part2\": %lld, \"runs\": [",
+           job->input.len, (long long)result->part1, (long long)result->part2);
+    for (int i = 0; i < runs; i++) {
+        const DayTimings* t = &job->phases[i];
+        printf("%s\n      {\"total_ms\": %.6f, \"parse_ms\": %.6f, \"part1_ms\": %.6f, \"part2_ms\": %.6f}",
+               i > 0 ? "," : "", job->samples[i], t->parse_ms, t->part1_ms, t->part2_ms);
+    }
+    printf("\n    ]");
+
+    if (counters) {
+        printf(", \"counters\": {");
+        bool first_event = true;
+        for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+            if (!job->counters.valid[e]) continue;
+            printf("%s\"%s\": %llu", first_event ? "" : ", ", perf_event_names[e],
+                   (unsigned long long)job->counters.values[e]);
+            first_event = false;
+        }
+        printf("}");
+    }
+
+    if (verify) {
+        VerifyStatus status = verify_day(job);
+        printf(", \"verify\": \"%s\"", verify_names[status]);
+        if (status == VERIFY_MISMATCH) {
+            printf(", \"expected\": {\"part1\": %lld, \"part2\": %lld}",
+                   (long long)job->expected[0], (long long)job->expected[1]);
+        }
+    }
+    printf("}");
+}
+
+// One row per measured run
+static void print_day_csv(const DayJob* job, int runs, const char* input_name) {
+    if (!job->input.data) {
+        fprintf(stderr, "Day %02d: Input not found\n", job->day);
         return;
     }
 
-    clock_t start = clock();
-    DayResult result = solvers[day - 1](input);
-    clock_t end = clock();
-    double time_ms = (double)(end - start) / CLOCKS_PER_SEC * 1000.0;
+    const DayResult* result = &job->result;
+    for (int i = 0; i < runs; i++) {
+        const DayTimings* t = &job->phases[i];
+        printf("%d,", job->day);
+        print_csv_string(input_name);
+        printf(",%zu,%lld,%lld,%d,%.6f,%.6f,%.6f,%.6f,", job->input.len,
+               (long long)result->part1, (long long)result->part2, i,
+               job->samples[i], t->parse_ms, t->part1_ms, t->part2_ms);
+        print_csv_string(BUILD_COMPILER);
+        putchar(',');
+        print_csv_string(BUILD_CFLAGS);
+        putchar('\n');
+    }
+}
 
-    printf("Day %02d: Part 1 = %lld, Part 2 = %lld (%.2f ms)\n",
-           day, (long long)result.part1, (long long)result.part2, time_ms);
+static void print_header(const RunOptions* opts) {
+    switch (opts->format) {
+    case FORMAT_TEXT:
+        printf("Advent of Code 2025 - C23\n");
+        printf("=========================\n\n");
+        break;
+    case FORMAT_JSON:
+        printf("{\n  \"compiler\": ");
+        print_json_string(BUILD_COMPILER);
+        printf(",\n  \"cflags\": ");
+        print_json_string(BUILD_CFLAGS);
+        printf(",\n  \"input\": ");
+        print_json_string(opts->input_name);
+        printf(",\n  \"iterations\": %d,\n  \"warmup\": %d,\n  \"jobs\": %d,\n  \"days\": [\n",
+               opts->bench.iterations > 0 ? opts->bench.iterations : 1,
+               opts->bench.iterations > 0 ? opts->bench.warmup : 0, opts->jobs);
+        break;
+    case FORMAT_CSV:
+        printf("day,input,input_bytes,part1,part2,iteration,total_ms,parse_ms,part1_ms,part2_ms,compiler,cflags\n");
+        break;
+    }
+}
 
-    free(input);
+static void print_footer(const RunOptions* opts) {
+    if (opts->format == FORMAT_JSON) printf("\n  ]\n}\n");
+}
+
+// Run every selected day on a pool of workers and print results in day order.
+// Returns the number of days that failed verification (0 without --verify).
+static int run_days(const int* days, int num_days, const RunOptions* opts) {
+    const BenchConfig* bench = &opts->bench;
+    int jobs = opts->jobs;
+    bool counters = opts->counters;
+    int runs = bench->iterations > 0 ? bench->iterations : 1;
+    int warmup = bench->iterations > 0 ? bench->warmup : 0;
+
+    DayJob* day_jobs = calloc(num_days, sizeof(DayJob));
+    Task* tasks = malloc((size_t)num_days * (warmup + runs) * sizeof(Task));
+    int num_tasks = 0;
+
+    for (int d = 0; d < num_days; d++) {
+        DayJob* job = &day_jobs[d];
+        job->day = days[d];
+        job->input = read_as_string(job->day, opts->input_name);
+        if (!job->input.data) continue;
+
+        if (opts->verify) {
+            job->has_answers = read_answers(job->day, opts->input_name,
+                                            &job->expected[0], &job->expected[1]);
+        }
+
+        job->runs_left = warmup + runs;
+        job->warmups_left = warmup;
+        job->samples = malloc(runs * sizeof(double));
+        job->phases = malloc(runs * sizeof(DayTimings));
+    }
+
+    // Queue warmups ahead of measured runs, day by day
+    for (int d = 0; d < num_days; d++) {
+        if (!day_jobs[d].input.data) continue;
+        for (int i = 0; i < warmup; i++) {
+            tasks[num_tasks++] = (Task){ &day_jobs[d], -1 };
+        }
+        for (int i = 0; i < runs; i++) {
+            tasks[num_tasks++] = (Task){ &day_jobs[d], i };
+        }
+    }
+
+    // Probe once up front so an unavailable PMU is reported a single time
+    if (counters) {
+        PerfCounters probe;
+        if (perf_open(&probe)) {
+            perf_close(&probe);
+        } else {
+            fprintf(stderr, "Performance counters unavailable; ignoring --counters\n");
+            counters = false;
+        }
+    }
+
+    // Resolve the solver thread count before any worker can ask for it
+    parallel_threads();
+
+    Runner runner = { .tasks = tasks, .num_tasks = num_tasks, .counters = counters };
+    atomic_init(&runner.next, 0);
+    pthread_mutex_init(&runner.lock, NULL);
+    pthread_cond_init(&runner.done, NULL);
+
+    if (jobs > num_tasks) jobs = num_tasks > 0 ? num_tasks : 1;
+    pthread_t* threads = malloc(jobs * sizeof(pthread_t));
+    int started = 0;
+    for (int i = 0; i < jobs; i++) {
+        if (pthread_create(&threads[started], NULL, worker, &runner) == 0) started++;
+    }
+
+    // If no worker could be started, run the whole queue on this thread
+    if (started == 0) worker(&runner);
+
+    int failures = 0;
+    int verified = 0;
+    print_header(opts);
+    for (int d = 0; d < num_days; d++) {
+        DayJob* job = &day_jobs[d];
+        if (job->input.data) {
+            pthread_mutex_lock(&runner.lock);
+            while (job->runs_left > 0) {
+                pthread_cond_wait(&runner.done, &runner.lock);
+            }
+            pthread_mutex_unlock(&runner.lock);
+        }
+
+        switch (opts->format) {
+        case FORMAT_TEXT:
+            if (job->input.data) {
+                print_day_text(job, bench, counters);
+            } else {
+                printf("Day %02d: Input not found\n", job->day);
+            }
+            if (opts->verify) print_verify_text(job, verify_day(job));
+            break;
+        case FORMAT_JSON:
+            print_day_json(job, runs, counters, opts->verify, d == 0);
+            break;
+        case FORMAT_CSV:
+            print_day_csv(job, runs, opts->input_name);
+            break;
+        }
+        fflush(stdout);
+
+        if (opts->verify) {
+            VerifyStatus status = verify_day(job);
+            if (status == VERIFY_OK) verified++;
+            // A missing or unreadable .answer file fails too, so a deleted
+            // answer can't let a day through unchecked
+            if (status != VERIFY_OK) failures++;
+        }
+    }
+    print_footer(opts);
+
+    if (opts->verify) {
+        // Keep machine-readable stdout clean
+        FILE* out = opts->format == FORMAT_TEXT ? stdout : stderr;
+        fprintf(out, "%sVerified %d of %d days, %d failed\n",
+                opts->format == FORMAT_TEXT ? "\n" : "", verified, num_days, failures);
+    }
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int d = 0; d < num_days; d++) {
+        unmap_file(&day_jobs[d].input);
+        free(day_jobs[d].samples);
+        free(day_jobs[d].phases);
+    }
+    pthread_cond_destroy(&runner.done);
+    pthread_mutex_destroy(&runner.lock);
+    free(threads);
+    free(tasks);
+    free(day_jobs);
+    return failures;
+}
+
+// Day 1 over a file or stdin in a single constant-memory pass
+static int run_stream(const char* path) {
+    int fd = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot open file: %s\n", path);
+        return 1;
+    }
+
+    DayResult result = day01_stream(fd);
+    if (fd != STDIN_FILENO) close(fd);
+
+    printf("Day 01: Part 1 = %lld, Part 2 = %lld (%.2f ms, streamed)\n",
+           (long long)result.part1, (long long)result.part2, result.timings.parse_ms);
+    return 0;
+}
+
+// Parse "2,12,20" into ks: plain numbers in [1, DAY03_MAX_DIGITS] separated
+// by single commas, at most DAY03_MAX_DIGITS of them. Returns the count, or
+// 0 if the list is malformed.
+static int parse_digit_counts(const char* list, int* ks) {
+    int num_ks = 0;
+    const char* p = list;
+    for (;;) {
+        if (*p < '0' || *p > '9' || num_ks == DAY03_MAX_DIGITS) return 0;
+        int k = 0;
+        while (*p >= '0' && *p <= '9') {
+            k = k * 10 + (*p++ - '0');
+            if (k > DAY03_MAX_DIGITS) return 0;
+        }
+        if (k < 1) return 0;
+        ks[num_ks++] = k;
+
+        if (*p == '\0') return num_ks;
+        if (*p++ != ',') return 0;
+    }
+}
+
+// Day 3 for a comma-separated list of digit counts, all in one pass
+static int run_digits(const char* list, const char* input_name) {
+    int ks[DAY03_MAX_DIGITS];
+    int num_ks = parse_digit_counts(list, ks);
+    if (num_ks == 0) {
+        fprintf(stderr, "Digit counts must be between 1 and %d\n", DAY03_MAX_DIGITS);
+        return 1;
+    }
+
+    InputView input = read_as_string(3, input_name);
+    if (!input.data) return 1;
+
+    u128 sums[DAY03_MAX_DIGITS];
+    int64_t start = clock_ns();
+    bool ok = day03_max_digit_sums(input.data, input.len, ks, num_ks, sums);
+    double ms = (clock_ns() - start) / 1e6;
+    unmap_file(&input);
+
+    if (!ok) {
+        fprintf(stderr, "Digit counts must be between 1 and %d\n", DAY03_MAX_DIGITS);
+        return 1;
+    }
+
+    char buf[40];
+    for (int j = 0; j < num_ks; j++) {
+        printf("Day 03: %2d digits = %s\n", ks[j], format_u128(sums[j], buf));
+    }
+    printf("(%.2f ms)\n", ms);
+    return 0;
+}
+
+// Day 4 rolls removed per synchronous round of the cascade
+static int run_rounds(const char* input_name) {
+    InputView input = read_as_string(4, input_name);
+    if (!input.data) return 1;
+
+    int64_t* rounds;
+    int num_rounds = day04_removal_rounds(input.data, input.len, &rounds);
+    unmap_file(&input);
+
+    int64_t total = 0;
+    for (int i = 0; i < num_rounds; i++) {
+        total += rounds[i];
+        printf("Day 04: round %d removed %lld\n", i + 1, (long long)rounds[i]);
+    }
+    printf("Day 04: %lld rolls in %d rounds\n", (long long)total, num_rounds);
+    free(rounds);
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
-    bool use_example = false;
-    int specific_days[12];
-    int num_specific = 0;
+    RunOptions opts = {
+        .input_name = "input",
+        .bench = { .iterations = 0, .warmup = 1 },
+        .jobs = 1,
+        .counters = false,
+        .verify = false,
+        .format = FORMAT_TEXT,
+    };
+    const char* stream_path = NULL;     // day 1 streaming input ("-" = stdin)
+    const char* digit_counts = NULL;    // day 3 digit counts ("2,12,20")
+    bool removal_rounds = false;        // day 4 per-round removal counts
+    bool threads_set = false;
+    int days[12];
+    int num_days = 0;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--example") == 0) {
-            use_example = true;
+            opts.input_name = "example";
+        } else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+            opts.input_name = argv[++i];
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            opts.bench.iterations = atoi(argv[++i]);
+            if (opts.bench.iterations < 1) opts.bench.iterations = 1;
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            opts.bench.warmup = atoi(argv[++i]);
+            if (opts.bench.warmup < 0) opts.bench.warmup = 0;
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            opts.jobs = atoi(argv[++i]);
+            if (opts.jobs < 1) opts.jobs = 1;
+        } else if (strcmp(argv[i], "--counters") == 0) {
+            opts.counters = true;
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            opts.verify = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            int threads = atoi(argv[++i]);
+            parallel_set_threads(threads < 1 ? 1 : threads);
+            threads_set = true;
+        } else if (strcmp(argv[i], "--fast-paths") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "on") == 0) {
+                fast_path_set_mode(FAST_PATHS_ON);
+            } else if (strcmp(mode, "off") == 0) {
+                fast_path_set_mode(FAST_PATHS_OFF);
+            } else if (strcmp(mode, "auto") == 0) {
+                fast_path_set_mode(FAST_PATHS_AUTO);
+            } else {
+                fprintf(stderr, "Unknown fast path mode: %s (expected auto, on or off)\n", mode);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc) {
+            stream_path = argv[++i];
+        } else if (strcmp(argv[i], "--digits") == 0 && i + 1 < argc) {
+            digit_counts = argv[++i];
+        } else if (strcmp(argv[i], "--range-index") == 0 && i + 1 < argc) {
+            if (!day05_set_index_file(argv[++i])) return 1;
+        } else if (strcmp(argv[i], "--rounds") == 0) {
+            removal_rounds = true;
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char* format = argv[++i];
+            if (strcmp(format, "json") == 0) {
+                opts.format = FORMAT_JSON;
+            } else if (strcmp(format, "csv") == 0) {
+                opts.format = FORMAT_CSV;
+            } else if (strcmp(format, "text") == 0) {
+                opts.format = FORMAT_TEXT;
+            } else {
+                fprintf(stderr, "Unknown format: %s (expected text, json or csv)\n", format);
+                return 1;
+            }
         } else {
             int day = atoi(argv[i]);
-            if (day >= 1 && day <= NUM_DAYS) {
-                specific_days[num_specific++] = day;
+            if (day >= 1 && day <= NUM_DAYS && num_days < NUM_DAYS) {
+                days[num_days++] = day;
             }
         }
     }
 
-    printf("Advent of Code 2025 - C23\n");
-    printf("=========================\n\n");
-
-    if (num_specific > 0) {
-        for (int i = 0; i < num_specific; i++) {
-            run_day(specific_days[i], use_example);
-        }
-    } else {
+    if (num_days == 0) {
         for (int day = 1; day <= NUM_DAYS; day++) {
-            run_day(day, use_example);
+            days[num_days++] = day;
         }
     }
 
-    return 0;
+    // Day workers split the CPUs with the solvers' own threads, unless
+    // --threads says otherwise
+    if (opts.jobs > 1 && !threads_set) {
+        int per_job = parallel_threads() / opts.jobs;
+        parallel_set_threads(per_job > 1 ? per_job : 1);
+    }
+
+    if (stream_path) return run_stream(stream_path);
+    if (digit_counts) return run_digits(digit_counts, opts.input_name);
+    if (removal_rounds) return run_rounds(opts.input_name);
+
+    int failures = run_days(days, num_days, &opts);
+
+    return failures > 0 ? 1 : 0;
 }
@@ -0,0 +1,450 @@
+// Synthetic input generator: writes valid puzzle inputs for every day,
+// scaled up from the size of the real inputs, with a fixed seed.
+//
+// Usage: gen [--seed S] [--out DIR] SCALE [days...]
+// Writes DIR/NN-xSCALE.txt (default DIR is inputs), e.g. inputs/08-x100.txt,
+// which the runner reads with --input xSCALE.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// splitmix64: small, fast and good enough for test data
+static uint64_t rng_state;
+
+static uint64_t rng_next(void) {
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform integer in [lo, hi]
+static int64_t rng_range(int64_t lo, int64_t hi) {
+    return lo + (int64_t)(rng_next() % (uint64_t)(hi - lo + 1));
+}
+
+static double rng_unit(void) {
+    return (double)(rng_next() >> 11) / (double)(1ULL << 53);
+}
+
+static int64_t power10(int exp) {
+    int64_t result = 1;
+    for (int i = 0; i < exp; i++) result *= 10;
+    return result;
+}
+
+// Side length of a square grid with `scale` times the area of a base side
+static int scaled_side(int base, int scale) {
+    return (int)lround(base * sqrt((double)scale));
+}
+
+// Day 1: dial rotations
+static void gen_day01(FILE* f, int scale) {
+    int n = 4500 * scale;
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%c%d\n", rng_next() & 1 ? 'R' : 'L', (int)rng_range(1, 999));
+    }
+}
+
+// Day 2: comma-separated id ranges on one line (ranges may overlap)
+static void gen_day02(FILE* f, int scale) {
+    int n = 35 * scale;
+    for (int i = 0; i < n; i++) {
+        int digits = (int)rng_range(2, 10);
+        int64_t lo = power10(digits - 1);
+        int64_t start = rng_range(lo, lo * 10 - 1);
+        int64_t end = start + rng_range(0, lo / 10 + 1000);
+        fprintf(f, "%s%lld-%lld", i > 0 ? "," : "", (long long)start, (long long)end);
+    }
+    fprintf(f, "\n");
+}
+
+// Day 3: battery banks of 100 digits
+static void gen_day03(FILE* f, int scale) {
+    int n = 200 * scale;
+    char line[101];
+    for (int i = 0; i < n; i++) {
+        for (int c = 0; c < 100; c++) line[c] = (char)('0' + rng_range(1, 9));
+        line[100] = '\0';
+        fprintf(f, "%s\n", line);
+    }
+}
+
+// Day 4: paper roll grid, about 65% rolls
+static void gen_day04(FILE* f, int scale) {
+    int side = scaled_side(139, scale);
+    char* line = malloc(side + 2);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) line[c] = rng_unit() < 0.65 ? '@' : '.';
+        line[side] = '\n';
+        line[side + 1] = '\0';
+        fputs(line, f);
+    }
+    free(line);
+}
+
+// Day 5: overlapping fresh ranges, a blank line, then ids (about half fresh)
+static void gen_day05(FILE* f, int scale) {
+    const int64_t max_value = 560000000000000LL;
+    int num_ranges = 190 * scale;
+    int num_ids = 1000 * scale;
+
+    int64_t* starts = malloc(num_ranges * sizeof(int64_t));
+    int64_t* ends = malloc(num_ranges * sizeof(int64_t));
+    for (int i = 0; i < num_ranges; i++) {
+        starts[i] = rng_range(1, max_value);
+        ends[i] = starts[i] + rng_range(0, 10000000000000LL / scale);
+        fprintf(f, "%lld-%lld\n", (long long)starts[i], (long long)ends[i]);
+    }
+    fprintf(f, "\n");
+
+    for (int i = 0; i < num_ids; i++) {
+        int64_t id;
+        if (rng_next() & 1) {
+            int r = (int)rng_range(0, num_ranges - 1);
+            id = rng_range(starts[r], ends[r]);
+        } else {
+            id = rng_range(1, max_value);
+        }
+        fprintf(f, "%lld\n", (long long)id);
+    }
+
+    free(starts);
+    free(ends);
+}
+
+// Day 6: four rows of numbers and a row of operators; each problem is a
+// column block aligned left or right, separated by a blank column
+static void gen_day06(FILE* f, int scale) {
+    enum { ROWS = 4 };
+    int n = 1000 * scale;
+
+    // Each problem needs at most 5 columns (4 digits + separator)
+    size_t cap = (size_t)n * 5 + 2;
+    char* lines[ROWS + 1];
+    for (int r = 0; r <= ROWS; r++) lines[r] = malloc(cap);
+    size_t pos = 0;
+
+    for (int i = 0; i < n; i++) {
+        int width = 0;
+        int nums[ROWS];
+        for (int r = 0; r < ROWS; r++) {
+            // Mostly short numbers so products stay in range at large scales
+            int digits = rng_unit() < 0.1 ? 4 : (int)rng_range(1, 3);
+            nums[r] = (int)rng_range(digits == 1 ? 1 : power10(digits - 1), power10(digits) - 1);
+            if (digits > width) width = digits;
+        }
+
+        bool right = rng_next() & 1;
+        if (i > 0) {
+            for (int r = 0; r <= ROWS; r++) lines[r][pos] = ' ';
+            pos++;
+        }
+        for (int r = 0; r < ROWS; r++) {
+            char buf[8];
+            int len = snprintf(buf, sizeof(buf), "%d", nums[r]);
+            int pad = width - len;
+            memset(lines[r] + pos, ' ', width);
+            memcpy(lines[r] + pos + (right ? pad : 0), buf, len);
+        }
+        memset(lines[ROWS] + pos, ' ', width);
+        lines[ROWS][pos] = rng_next() & 1 ? '*' : '+';
+        pos += width;
+    }
+
+    for (int r = 0; r <= ROWS; r++) {
+        lines[r][pos] = '\n';
+        fwrite(lines[r], 1, pos + 1, f);
+        free(lines[r]);
+    }
+}
+
+// Day 7: beam grid with splitters inside the beam's reach on every other
+// row. Splitter density drops with height so the timeline count (which
+// roughly doubles per splitter hit) stays well inside int64.
+static void gen_day07(FILE* f, int scale) {
+    int rows = scaled_side(142, scale);
+    if (rows % 2) rows++;
+    int cols = rows - 1;
+    int start = cols / 2;
+
+    int splitter_rows = rows / 2 - 1;
+    double density = exp(log(1e15) / splitter_rows) - 1.0;
+    if (density > 0.64) density = 0.64;
+
+    char* line = malloc(cols + 2);
+    for (int r = 0; r < rows; r++) {
+        memset(line, '.', cols);
+        if (r == 0) {
+            line[start] = 'S';
+        } else if (r % 2 == 0) {
+            int reach = r / 2 - 1;
+            for (int c = start - reach; c <= start + reach; c += 2) {
+                if (c >= 0 && c < cols && rng_unit() < density) line[c] = '^';
+            }
+        }
+        line[cols] = '\n';
+        line[cols + 1] = '\0';
+        fputs(line, f);
+    }
+    free(line);
+}
+
+// Day 8: junction boxes in 3D. The solver sorts every pair of points, so
+// the count stops growing at DAY08_MAX_POINTS (4.5M pairs); at 100x the
+// pair list alone would be 80 GB.
+#define DAY08_MAX_POINTS 3000
+
+static void gen_day08(FILE* f, int scale) {
+    int n = scale < DAY08_MAX_POINTS / 1000 ? 1000 * scale : DAY08_MAX_POINTS;
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%d,%d,%d\n", (int)rng_range(0, 99999), (int)rng_range(0, 99999),
+                (int)rng_range(0, 99999));
+    }
+}
+
+// Day 9: red tiles at the corners of a simple rectilinear polygon. The top
+// is a staircase above base_y running right, the bottom a staircase below it
+// running back left, over the same strictly increasing x positions.
+static void gen_day09(FILE* f, int scale) {
+    const int64_t base_y = 100000;
+    const int64_t max_step = 40000;
+    int k = 124 * scale;    // 4 corners per x position
+
+    int64_t* xs = malloc((k + 1) * sizeof(int64_t));
+    int64_t* top = malloc(k * sizeof(int64_t));
+    int64_t* bottom = malloc(k * sizeof(int64_t));
+
+    int64_t gap = 200000 / k;
+    if (gap < 2) gap = 2;
+    xs[0] = rng_range(1, 1000);
+    for (int i = 1; i <= k; i++) xs[i] = xs[i - 1] + rng_range(1, gap);
+
+    // Heights between 1 and max_step away from base_y; neighbours differ
+    for (int i = 0; i < k; i++) {
+        int64_t prev_top = i > 0 ? top[i - 1] : 0;
+        int64_t prev_bottom = i > 0 ? bottom[i - 1] : 0;
+        do top[i] = rng_range(1, max_step); while (top[i] == prev_top);
+        do bottom[i] = rng_range(1, max_step); while (bottom[i] == prev_bottom);
+    }
+
+    for (int i = 0; i < k; i++) {
+        fprintf(f, "%lld,%lld\n", (long long)xs[i], (long long)(base_y + top[i]));
+        fprintf(f, "%lld,%lld\n", (long long)xs[i + 1], (long long)(base_y + top[i]));
+    }
+    for (int i = k - 1; i >= 0; i--) {
+        fprintf(f, "%lld,%lld\n", (long long)xs[i + 1], (long long)(base_y - bottom[i]));
+        fprintf(f, "%lld,%lld\n", (long long)xs[i], (long long)(base_y - bottom[i]));
+    }
+
+    free(xs);
+    free(top);
+    free(bottom);
+}
+
+// Day 10: machines whose light pattern and joltages come from an actual
+// set of button presses, so both parts are always solvable
+static void gen_day10(FILE* f, int scale) {
+    int n = 200 * scale;
+    for (int m = 0; m < n; m++) {
+        int lights = (int)rng_range(4, 10);
+        int buttons = (int)rng_range(lights - 1, lights + 3);
+
+        int lit[10] = {0};
+        int joltage[10] = {0};
+        uint32_t masks[16];
+        for (int b = 0; b < buttons; b++) {
+            do masks[b] = (uint32_t)rng_next() & ((1u << lights) - 1);
+            while (masks[b] == 0 || masks[b] == (1u << lights) - 1);
+
+            bool toggled = rng_next() & 1;
+            int presses = (int)rng_range(0, 30);
+            for (int l = 0; l < lights; l++) {
+                if (!(masks[b] >> l & 1)) continue;
+                if (toggled) lit[l] ^= 1;
+                joltage[l] += presses;
+            }
+        }
+
+        fprintf(f, "[");
+        for (int l = 0; l < lights; l++) fputc(lit[l] ? '#' : '.', f);
+        fprintf(f, "]");
+        for (int b = 0; b < buttons; b++) {
+            fprintf(f, " (");
+            bool first = true;
+            for (int l = 0; l < lights; l++) {
+                if (!(masks[b] >> l & 1)) continue;
+                fprintf(f, "%s%d", first ? "" : ",", l);
+                first = false;
+            }
+            fprintf(f, ")");
+        }
+        fprintf(f, " {");
+        for (int l = 0; l < lights; l++) fprintf(f, "%s%d", l > 0 ? "," : "", joltage[l]);
+        fprintf(f, "}\n");
+    }
+}
+
+// Unique lowercase device name for node i (3 letters while they last)
+static void node_name(int i, char* out) {
+    int len = 3;
+    for (int64_t count = 26 * 26 * 26; i >= count; count *= 26) {
+        i -= (int)count;
+        len++;
+    }
+    for (int c = len - 1; c >= 0; c--) {
+        out[c] = (char)('a' + i % 26);
+        i /= 26;
+    }
+    out[len] = '\0';
+}
+
+// Day 11: layered DAG. Node 0 of each layer links to node 0 of the next
+// (a spine that svr, fft, dac and out sit on), so every required path
+// exists; the layer count is fixed so path counts don't grow with scale.
+static void gen_day11(FILE* f, int scale) {
+    enum { LAYERS = 24 };
+    int width = 24 * scale;
+    int total = LAYERS * width;
+
+    // Names, with the special devices on the spine
+    char (*names)[16] = malloc((size_t)total * sizeof(*names));
+    int next_name = 0;
+    for (int i = 0; i < total; i++) {
+        do node_name(next_name++, names[i]);
+        while (!strcmp(names[i], "svr") || !strcmp(names[i], "you") || !strcmp(names[i], "fft") ||
+               !strcmp(names[i], "dac") || !strcmp(names[i], "out"));
+    }
+    strcpy(names[0], "svr");
+    strcpy(names[width + 1 < total ? width + 1 : 1], "you");
+    strcpy(names[(LAYERS / 3) * width], "fft");
+    strcpy(names[(2 * LAYERS / 3) * width], "dac");
+    strcpy(names[(LAYERS - 1) * width], "out");
+
+    for (int layer = 0; layer < LAYERS - 1; layer++) {
+        int next = (layer + 1) * width;
+        for (int j = 0; j < width; j++) {
+            int node = layer * width + j;
+            int degree = (int)rng_range(1, width < 3 ? width : 3);
+
+            // Distinct targets; the spine edge comes first
+            int targets[3];
+            for (int d = 0; d < degree; d++) {
+                bool dup;
+                do {
+                    targets[d] = (j == 0 && d == 0) ? 0 : (int)rng_range(0, width - 1);
+                    dup = false;
+                    for (int e = 0; e < d; e++) dup |= targets[e] == targets[d];
+                } while (dup);
+            }
+
+            fprintf(f, "%s:", names[node]);
+            for (int d = 0; d < degree; d++) fprintf(f, " %s", names[next + targets[d]]);
+            fprintf(f, "\n");
+        }
+    }
+
+    free(names);
+}
+
+// Day 12: six 7-cell presents, then regions that either trivially fit
+// (one 3x3 box per present) or have less area than the presents need
+static void gen_day12(FILE* f, int scale) {
+    static const char* shapes[6][3] = {
+        { "###", "#..", "###" },
+        { "###", ".#.", "###" },
+        { "##.", "###", ".##" },
+        { "#.#", "###", "#.#" },
+        { "###", "##.", "#.#" },
+        { ".##", "###", "##." },
+    };
+    for (int s = 0; s < 6; s++) {
+        fprintf(f, "%d:\n%s\n%s\n%s\n\n", s, shapes[s][0], shapes[s][1], shapes[s][2]);
+    }
+
+    int n = 1000 * scale;
+    for (int i = 0; i < n; i++) {
+        int w = (int)rng_range(35, 50);
+        int h = (int)rng_range(35, 50);
+        bool fits = rng_unit() < 0.6;
+
+        // Target a total present count on the chosen side of the bound
+        int boxes = (w / 3) * (h / 3);
+        int total = fits ? (int)rng_range(boxes * 3 / 4, boxes)
+                         : (int)rng_range(w * h / 7 + 1, w * h / 7 + 30);
+
+        int counts[6] = {0};
+        for (int p = 0; p < total; p++) counts[rng_range(0, 5)]++;
+
+        fprintf(f, "%dx%d:", w, h);
+        for (int s = 0; s < 6; s++) fprintf(f, " %d", counts[s]);
+        fprintf(f, "\n");
+    }
+}
+
+typedef void (*Generator)(FILE* f, int scale);
+
+static const Generator generators[] = {
+    gen_day01, gen_day02, gen_day03, gen_day04, gen_day05, gen_day06,
+    gen_day07, gen_day08, gen_day09, gen_day10, gen_day11, gen_day12
+};
+
+static const int NUM_DAYS = sizeof(generators) / sizeof(generators[0]);
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = 2025;
+    const char* out_dir = "inputs";
+    int scale = 0;
+    int days[12];
+    int num_days = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (scale == 0) {
+            scale = atoi(argv[i]);
+        } else {
+            int day = atoi(argv[i]);
+            if (day >= 1 && day <= NUM_DAYS && num_days < NUM_DAYS) {
+                days[num_days++] = day;
+            }
+        }
+    }
+
+    if (scale < 1) {
+        fprintf(stderr, "Usage: %s [--seed S] [--out DIR] SCALE [days...]\n", argv[0]);
+        return 1;
+    }
+
+    if (num_days == 0) {
+        for (int day = 1; day <= NUM_DAYS; day++) {
+            days[num_days++] = day;
+        }
+    }
+
+    for (int d = 0; d < num_days; d++) {
+        int day = days[d];
+        char filename[256];
+        snprintf(filename, sizeof(filename), "%s/%02d-x%d.txt", out_dir, day, scale);
+
+        FILE* f = fopen(filename, "w");
+        if (!f) {
+            fprintf(stderr, "Cannot write file: %s\n", filename);
+            return 1;
+        }
+
+        // Seed per day so a day's data doesn't depend on which days are generated
+        rng_state = seed * 0x100000001B3ULL + (uint64_t)day;
+        generators[day - 1](f, scale);
+        fclose(f);
+        printf("Wrote %s\n", filename);
+    }
+
+    return 0;
+}